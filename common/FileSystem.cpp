@@ -1232,6 +1232,32 @@ bool FileSystem::WriteStringToFile(const char* filename, const std::string_view
 	return true;
 }
 
+bool FileSystem::WriteAtomicRenamedFile(const char* filename, const std::function<bool(std::FILE*)>& write, Error* error)
+{
+	const std::string temp_filename = std::string(filename) + ".tmp";
+	ManagedCFilePtr fp = OpenManagedCFile(temp_filename.c_str(), "wb", error);
+	if (!fp)
+		return false;
+
+	const bool written = write(fp.get()) && std::fflush(fp.get()) == 0 && !std::ferror(fp.get());
+	fp.reset();
+
+	if (!written)
+	{
+		Error::SetStringFmt(error, "Failed to write '{}'", temp_filename);
+		DeleteFilePath(temp_filename.c_str());
+		return false;
+	}
+
+	if (!RenamePath(temp_filename.c_str(), filename, error))
+	{
+		DeleteFilePath(temp_filename.c_str());
+		return false;
+	}
+
+	return true;
+}
+
 size_t FileSystem::ReadFileWithProgress(std::FILE* fp, void* dst, size_t length,
 	ProgressCallback* progress, Error* error, size_t chunk_size)
 {
@@ -7,6 +7,7 @@
 
 #include <cstdio>
 #include <ctime>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <span>
@@ -143,6 +144,10 @@ namespace FileSystem
 	std::optional<std::string> ReadFileToString(std::FILE* fp);
 	bool WriteBinaryFile(const char* filename, const void* data, size_t data_length);
 	bool WriteStringToFile(const char* filename, const std::string_view sv);
+
+	/// Writes to a temporary file next to filename, which is renamed over it once write returns true.
+	/// An interrupted or failed write leaves either the old or the new file behind, never a truncated one.
+	bool WriteAtomicRenamedFile(const char* filename, const std::function<bool(std::FILE*)>& write, Error* error = nullptr);
 	size_t ReadFileWithProgress(std::FILE* fp, void* dst, size_t length, ProgressCallback* progress,
 		Error* error = nullptr, size_t chunk_size = 16 * 1024 * 1024);
 	size_t ReadFileWithPartialProgress(std::FILE* fp, void* dst, size_t length, ProgressCallback* progress,
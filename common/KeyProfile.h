@@ -0,0 +1,79 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "common/Console.h"
+#include "common/FileSystem.h"
+
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Profiles of the JIT keys a game used, so they can be compiled ahead of time on the next run.
+// Each profile holds two lists of keys, e.g. one per recompiler or function type.
+// Layout: [magic][version][first count][second count][first keys...][second keys...]
+namespace KeyProfile
+{
+	/// Keeps a corrupted or runaway profile from filling the code cache.
+	static constexpr u32 MAX_ENTRIES = 16384;
+
+	/// Reads both key lists. Returns false if the profile doesn't exist or is invalid.
+	template <typename T>
+	static inline bool Load(const std::string& path, u32 magic, u32 version, std::vector<T>* first, std::vector<T>* second)
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+
+		std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(path.c_str());
+		if (!data.has_value())
+			return false;
+
+		u32 header[4];
+		if (data->size() < sizeof(header))
+			return false;
+
+		std::memcpy(header, data->data(), sizeof(header));
+		if (header[0] != magic || header[1] != version || header[2] > MAX_ENTRIES || header[3] > MAX_ENTRIES ||
+			data->size() != sizeof(header) + (header[2] + header[3]) * sizeof(T))
+		{
+			Console.Warning("Ignoring invalid JIT profile '%s'", path.c_str());
+			return false;
+		}
+
+		first->resize(header[2]);
+		second->resize(header[3]);
+		std::memcpy(first->data(), data->data() + sizeof(header), header[2] * sizeof(T));
+		std::memcpy(second->data(), data->data() + sizeof(header) + header[2] * sizeof(T), header[3] * sizeof(T));
+		return true;
+	}
+
+	/// Writes up to MAX_ENTRIES keys from each container.
+	template <typename T, typename FirstContainer, typename SecondContainer>
+	static inline bool Save(const std::string& path, u32 magic, u32 version, const FirstContainer& first, const SecondContainer& second)
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+
+		const u32 counts[2] = {std::min<u32>(static_cast<u32>(first.size()), MAX_ENTRIES),
+			std::min<u32>(static_cast<u32>(second.size()), MAX_ENTRIES)};
+		const u32 header[4] = {magic, version, counts[0], counts[1]};
+
+		std::vector<u8> data(sizeof(header) + (counts[0] + counts[1]) * sizeof(T));
+		std::memcpy(data.data(), header, sizeof(header));
+
+		u8* ptr = data.data() + sizeof(header);
+		const auto write_keys = [&ptr](const auto& keys, u32 count) {
+			for (auto it = keys.begin(); count > 0; ++it, count--, ptr += sizeof(T))
+			{
+				const T key = *it;
+				std::memcpy(ptr, &key, sizeof(T));
+			}
+		};
+		write_keys(first, counts[0]);
+		write_keys(second, counts[1]);
+
+		return FileSystem::WriteBinaryFile(path.c_str(), data.data(), data.size());
+	}
+} // namespace KeyProfile
@@ -14,17 +14,26 @@
 #include <cstring>
 
 #ifdef __linux__
+#include <algorithm>
 #include <atomic>
 #include <ctime>
+#include <map>
 #include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 #include <elf.h>
+#include <signal.h>
+#include <ucontext.h>
 #include <unistd.h>
 #include <sys/mman.h>
 #include <sys/syscall.h>
+#include <sys/time.h>
 #endif
 
 //#define ProfileWithPerf
 //#define ProfileWithPerfJitDump
+//#define ProfileWithPerfSampling
 
 #if defined(ENABLE_VTUNE) && defined(_WIN32)
 #pragma comment(lib, "jitprofiling.lib")
@@ -44,7 +53,7 @@ namespace Perf
 	static std::FILE* s_map_file = nullptr;
 	static bool s_map_file_opened = false;
 	static std::mutex s_mutex;
-	static void RegisterMethod(const void* ptr, size_t size, const char* symbol)
+	static void RegisterMethod(const void* ptr, size_t size, const char* symbol, const std::vector<PCMapping>* mappings)
 	{
 		std::unique_lock lock(s_mutex);
 
@@ -103,6 +112,20 @@ namespace Perf
 		u64 code_index;
 		// name
 	};
+	struct JITDUMP_DEBUG_INFO
+	{
+		JITDUMP_RECORD_HEADER header;
+		u64 code_addr;
+		u64 nr_entry;
+		// entries
+	};
+	struct JITDUMP_DEBUG_ENTRY
+	{
+		u64 code_addr;
+		u32 line;
+		u32 discrim;
+		// file name
+	};
 #pragma pack(pop)
 
 	static u64 JitDumpTimestamp()
@@ -117,7 +140,7 @@ namespace Perf
 	static std::mutex s_jitdump_mutex;
 	static u32 s_jitdump_record_id;
 
-	static void RegisterMethod(const void* ptr, size_t size, const char* symbol)
+	static void RegisterMethod(const void* ptr, size_t size, const char* symbol, const std::vector<PCMapping>* mappings)
 	{
 		const u32 namelen = std::strlen(symbol) + 1;
 
@@ -150,6 +173,35 @@ namespace Perf
 			std::fwrite(&jh, sizeof(jh), 1, s_jitdump_file);
 		}
 
+		// Debug info has to come before the code it describes.
+		// The guest pc is stored as the line number, with the symbol prefix as the file name.
+		if (mappings && !mappings->empty())
+		{
+			const char* filename = symbol;
+			u32 filenamelen = namelen;
+			if (const char* sep = std::strchr(symbol, '_'))
+				filenamelen = static_cast<u32>(sep - symbol) + 1;
+
+			JITDUMP_DEBUG_INFO di = {};
+			di.header.id = JIT_CODE_DEBUG_INFO;
+			di.header.total_size = sizeof(di) + static_cast<u32>(mappings->size() * (sizeof(JITDUMP_DEBUG_ENTRY) + filenamelen));
+			di.header.timestamp = JitDumpTimestamp();
+			di.code_addr = static_cast<u64>(reinterpret_cast<uintptr_t>(ptr));
+			di.nr_entry = mappings->size();
+			std::fwrite(&di, sizeof(di), 1, s_jitdump_file);
+
+			static constexpr char zero = 0;
+			for (const PCMapping& mapping : *mappings)
+			{
+				JITDUMP_DEBUG_ENTRY de = {};
+				de.code_addr = static_cast<u64>(reinterpret_cast<uintptr_t>(mapping.code));
+				de.line = mapping.pc;
+				std::fwrite(&de, sizeof(de), 1, s_jitdump_file);
+				std::fwrite(filename, filenamelen - 1, 1, s_jitdump_file);
+				std::fwrite(&zero, 1, 1, s_jitdump_file);
+			}
+		}
+
 		JITDUMP_CODE_LOAD cl = {};
 		cl.header.id = JIT_CODE_LOAD;
 		cl.header.total_size = sizeof(cl) + namelen + static_cast<u32>(size);
@@ -166,7 +218,7 @@ namespace Perf
 		std::fflush(s_jitdump_file);
 	}
 #elif defined(ENABLE_VTUNE)
-	static void RegisterMethod(const void* ptr, size_t size, const char* symbol)
+	static void RegisterMethod(const void* ptr, size_t size, const char* symbol, const std::vector<PCMapping>* mappings)
 	{
 		iJIT_Method_Load_V2 ml = {};
 		ml.method_id = iJIT_GetNewMethodID();
@@ -177,7 +229,233 @@ namespace Perf
 	}
 #endif
 
+#if defined(__linux__) && defined(ProfileWithPerfSampling)
+	// Samples are pushed by the signal handler, and attributed to registered code under s_sample_mutex.
+	// Attribution happens before code is replaced, so samples land on the code that was running.
+	static constexpr u32 SAMPLE_BUFFER_SIZE = 64 * 1024;
+	static std::array<std::atomic<uptr>, SAMPLE_BUFFER_SIZE> s_samples;
+	static std::atomic<u32> s_sample_write{0};
+	static std::atomic<u32> s_sample_read{0};
+	static std::atomic<u32> s_samples_dropped{0};
+
+	struct SampledRange
+	{
+		uptr end;
+		std::string symbol;
+	};
+
+	static std::mutex s_sample_mutex;
+	static std::map<uptr, SampledRange> s_sample_ranges;
+	static std::unordered_map<std::string, u64> s_sample_counts;
+	static u64 s_samples_host = 0;
+	static bool s_sampling = false;
+	static struct sigaction s_old_sigprof;
+
+	static void SampleSignalHandler(int sig, siginfo_t* info, void* ctx)
+	{
+		const ucontext_t* uc = static_cast<const ucontext_t*>(ctx);
+#if defined(ARCH_X86)
+		const uptr pc = static_cast<uptr>(uc->uc_mcontext.gregs[REG_RIP]);
+#elif defined(ARCH_ARM64)
+		const uptr pc = static_cast<uptr>(uc->uc_mcontext.pc);
+#else
+#error Unhandled architecture.
+#endif
+
+		u32 pos = s_sample_write.load(std::memory_order_relaxed);
+		do
+		{
+			if ((pos - s_sample_read.load(std::memory_order_acquire)) >= SAMPLE_BUFFER_SIZE)
+			{
+				s_samples_dropped.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+		} while (!s_sample_write.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed));
+
+		s_samples[pos % SAMPLE_BUFFER_SIZE].store(pc, std::memory_order_release);
+	}
+
+	static void ResolveSamples()
+	{
+		u32 pos = s_sample_read.load(std::memory_order_relaxed);
+		const u32 end = s_sample_write.load(std::memory_order_acquire);
+		for (; pos != end; pos++)
+		{
+			// Zero means the slot was claimed, but the handler hasn't stored to it yet.
+			const uptr pc = s_samples[pos % SAMPLE_BUFFER_SIZE].exchange(0, std::memory_order_acquire);
+			if (pc == 0)
+				break;
+
+			auto it = s_sample_ranges.upper_bound(pc);
+			if (it != s_sample_ranges.begin() && pc < (--it)->second.end)
+				s_sample_counts[it->second.symbol]++;
+			else
+				s_samples_host++;
+		}
+		s_sample_read.store(pos, std::memory_order_release);
+	}
+
+	static void SampleRegisterMethod(const void* ptr, size_t size, const char* symbol)
+	{
+		const uptr start = reinterpret_cast<uptr>(ptr);
+		const uptr end = start + size;
+
+		std::unique_lock lock(s_sample_mutex);
+		if (!s_sampling)
+			return;
+
+		ResolveSamples();
+
+		// Drop anything this code has overwritten.
+		auto it = s_sample_ranges.upper_bound(start);
+		if (it != s_sample_ranges.begin() && std::prev(it)->second.end > start)
+			--it;
+		while (it != s_sample_ranges.end() && it->first < end)
+			it = s_sample_ranges.erase(it);
+
+		s_sample_ranges.emplace(start, SampledRange{end, symbol});
+	}
+
+	bool StartSampling(u32 interval_us)
+	{
+		std::unique_lock lock(s_sample_mutex);
+		if (s_sampling)
+			return true;
+
+		struct sigaction sa = {};
+		sa.sa_sigaction = SampleSignalHandler;
+		sa.sa_flags = SA_SIGINFO | SA_RESTART;
+		sigemptyset(&sa.sa_mask);
+		if (sigaction(SIGPROF, &sa, &s_old_sigprof) != 0)
+			return false;
+
+		itimerval timer = {};
+		timer.it_interval.tv_sec = interval_us / 1000000;
+		timer.it_interval.tv_usec = interval_us % 1000000;
+		timer.it_value = timer.it_interval;
+		if (setitimer(ITIMER_PROF, &timer, nullptr) != 0)
+		{
+			sigaction(SIGPROF, &s_old_sigprof, nullptr);
+			return false;
+		}
+
+		s_sampling = true;
+		return true;
+	}
+
+	void StopSampling()
+	{
+		std::unique_lock lock(s_sample_mutex);
+		if (!s_sampling)
+			return;
+
+		itimerval timer = {};
+		setitimer(ITIMER_PROF, &timer, nullptr);
+		sigaction(SIGPROF, &s_old_sigprof, nullptr);
+
+		ResolveSamples();
+		s_sample_ranges.clear();
+		s_sample_counts.clear();
+		s_samples_host = 0;
+		s_samples_dropped.store(0, std::memory_order_relaxed);
+		s_sampling = false;
+	}
+
+	bool IsSampling()
+	{
+		std::unique_lock lock(s_sample_mutex);
+		return s_sampling;
+	}
+
+	void DrainSamples()
+	{
+		std::unique_lock lock(s_sample_mutex);
+		if (s_sampling)
+			ResolveSamples();
+	}
+
+	bool WriteSamplingReport(const char* path)
+	{
+		std::unique_lock lock(s_sample_mutex);
+		if (!s_sampling)
+			return false;
+
+		ResolveSamples();
+
+		std::vector<std::pair<const std::string*, u64>> symbols;
+		std::unordered_map<std::string, u64> groups;
+		u64 total = s_samples_host;
+		symbols.reserve(s_sample_counts.size());
+		for (const auto& [symbol, count] : s_sample_counts)
+		{
+			symbols.emplace_back(&symbol, count);
+			const size_t sep = symbol.find('_');
+			groups[(sep != std::string::npos) ? symbol.substr(0, sep) : std::string("Other")] += count;
+			total += count;
+		}
+		std::sort(symbols.begin(), symbols.end(), [](const auto& lhs, const auto& rhs) { return lhs.second > rhs.second; });
+
+		std::vector<std::pair<std::string, u64>> sorted_groups(groups.begin(), groups.end());
+		std::sort(sorted_groups.begin(), sorted_groups.end(), [](const auto& lhs, const auto& rhs) { return lhs.second > rhs.second; });
+
+		std::FILE* fp = std::fopen(path, "wb");
+		if (!fp)
+			return false;
+
+		const auto percent = [total](u64 count) { return total ? (static_cast<double>(count) * 100.0 / static_cast<double>(total)) : 0.0; };
+
+		std::fprintf(fp, "Samples: %" PRIu64 " (%u dropped), outside registered code: %" PRIu64 " (%.2f%%)\n\n",
+			total, s_samples_dropped.load(std::memory_order_relaxed), s_samples_host, percent(s_samples_host));
+
+		std::fprintf(fp, "Flat:\n");
+		for (const auto& [symbol, count] : symbols)
+			std::fprintf(fp, "%7.2f%% %10" PRIu64 "  %s\n", percent(count), count, symbol->c_str());
+
+		std::fprintf(fp, "\nBy group:\n");
+		for (const auto& [group, group_count] : sorted_groups)
+		{
+			std::fprintf(fp, "%7.2f%% %10" PRIu64 "  %s\n", percent(group_count), group_count, group.c_str());
+			for (const auto& [symbol, count] : symbols)
+			{
+				const size_t sep = symbol->find('_');
+				const std::string_view symbol_group = (sep != std::string::npos) ? std::string_view(*symbol).substr(0, sep) : std::string_view("Other");
+				if (symbol_group == group)
+					std::fprintf(fp, "  %7.2f%% %10" PRIu64 "  %s\n", percent(count), count, symbol->c_str());
+			}
+		}
+
+		std::fclose(fp);
+
+		s_sample_counts.clear();
+		s_samples_host = 0;
+		s_samples_dropped.store(0, std::memory_order_relaxed);
+		return true;
+	}
+#else
+	bool StartSampling(u32 interval_us) { return false; }
+	void StopSampling() {}
+	bool IsSampling() { return false; }
+	void DrainSamples() {}
+	bool WriteSamplingReport(const char* path) { return false; }
+#endif
+
+#if defined(__linux__) && defined(ProfileWithPerfJitDump)
+	bool IsRecordingDebugInfo() { return true; }
+#else
+	bool IsRecordingDebugInfo() { return false; }
+#endif
+
+#if (defined(__linux__) && (defined(ProfileWithPerf) || defined(ProfileWithPerfJitDump) || defined(ProfileWithPerfSampling))) || defined(ENABLE_VTUNE)
+	static void RegisterSymbol(const void* ptr, size_t size, const char* symbol, const std::vector<PCMapping>* mappings)
+	{
 #if (defined(__linux__) && (defined(ProfileWithPerf) || defined(ProfileWithPerfJitDump))) || defined(ENABLE_VTUNE)
+		RegisterMethod(ptr, size, symbol, mappings);
+#endif
+#if defined(__linux__) && defined(ProfileWithPerfSampling)
+		SampleRegisterMethod(ptr, size, symbol);
+#endif
+	}
+
 	void Group::Register(const void* ptr, size_t size, const char* symbol)
 	{
 		char full_symbol[128];
@@ -185,7 +463,7 @@ namespace Perf
 			std::snprintf(full_symbol, std::size(full_symbol), "%s_%s", m_prefix, symbol);
 		else
 			StringUtil::Strlcpy(full_symbol, symbol, std::size(full_symbol));
-		RegisterMethod(ptr, size, full_symbol);
+		RegisterSymbol(ptr, size, full_symbol, nullptr);
 	}
 
 	void Group::RegisterPC(const void* ptr, size_t size, u32 pc)
@@ -195,7 +473,17 @@ namespace Perf
 			std::snprintf(full_symbol, std::size(full_symbol), "%s_%08X", m_prefix, pc);
 		else
 			std::snprintf(full_symbol, std::size(full_symbol), "%08X", pc);
-		RegisterMethod(ptr, size, full_symbol);
+		RegisterSymbol(ptr, size, full_symbol, nullptr);
+	}
+
+	void Group::RegisterPC(const void* ptr, size_t size, u32 pc, const std::vector<PCMapping>& mappings)
+	{
+		char full_symbol[128];
+		if (HasPrefix())
+			std::snprintf(full_symbol, std::size(full_symbol), "%s_%08X", m_prefix, pc);
+		else
+			std::snprintf(full_symbol, std::size(full_symbol), "%08X", pc);
+		RegisterSymbol(ptr, size, full_symbol, &mappings);
 	}
 
 	void Group::RegisterKey(const void* ptr, size_t size, const char* prefix, u64 key)
@@ -205,11 +493,12 @@ namespace Perf
 			std::snprintf(full_symbol, std::size(full_symbol), "%s_%s%016" PRIX64, m_prefix, prefix, key);
 		else
 			std::snprintf(full_symbol, std::size(full_symbol), "%s%016" PRIX64, prefix, key);
-		RegisterMethod(ptr, size, full_symbol);
+		RegisterSymbol(ptr, size, full_symbol, nullptr);
 	}
 #else
 	void Group::Register(const void* ptr, size_t size, const char* symbol) {}
 	void Group::RegisterPC(const void* ptr, size_t size, u32 pc) {}
+	void Group::RegisterPC(const void* ptr, size_t size, u32 pc, const std::vector<PCMapping>& mappings) {}
 	void Group::RegisterKey(const void* ptr, size_t size, const char* prefix, u64 key) {}
 #endif
 } // namespace Perf
@@ -9,6 +9,13 @@
 
 namespace Perf
 {
+	// Host code generated for a guest instruction, written as jitdump debug info.
+	struct PCMapping
+	{
+		const void* code;
+		u32 pc;
+	};
+
 	class Group
 	{
 		const char* m_prefix;
@@ -19,9 +26,23 @@ namespace Perf
 
 		void Register(const void* ptr, size_t size, const char* symbol);
 		void RegisterPC(const void* ptr, size_t size, u32 pc);
+		void RegisterPC(const void* ptr, size_t size, u32 pc, const std::vector<PCMapping>& mappings);
 		void RegisterKey(const void* ptr, size_t size, const char* prefix, u64 key);
 	};
 
+	// Recompilers only need to build PCMappings when this is true.
+	bool IsRecordingDebugInfo();
+
+	// Sampling profiler, attributes host CPU time to registered code.
+	// Only available on Linux, when built with ProfileWithPerfSampling.
+	bool StartSampling(u32 interval_us);
+	void StopSampling();
+	bool IsSampling();
+	// Attributes the buffered samples, call regularly so the buffer doesn't fill up between code changes.
+	void DrainSamples();
+	// Writes a flat and a per group report, then clears the collected samples.
+	bool WriteSamplingReport(const char* path);
+
 	extern Group any;
 	extern Group ee;
 	extern Group iop;
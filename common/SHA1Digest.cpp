@@ -0,0 +1,147 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "SHA1Digest.h"
+#include <cstring>
+
+// straightforward implementation of FIPS 180-4.
+
+static inline u32 SHA1Rotate(u32 value, u32 bits)
+{
+  return (value << bits) | (value >> (32 - bits));
+}
+
+static void SHA1Transform(u32 state[5], const u8 block[64])
+{
+  u32 w[80];
+  for (u32 i = 0; i < 16; i++)
+  {
+    w[i] = (static_cast<u32>(block[i * 4]) << 24) | (static_cast<u32>(block[i * 4 + 1]) << 16) |
+           (static_cast<u32>(block[i * 4 + 2]) << 8) | static_cast<u32>(block[i * 4 + 3]);
+  }
+  for (u32 i = 16; i < 80; i++)
+    w[i] = SHA1Rotate(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+  u32 a = state[0];
+  u32 b = state[1];
+  u32 c = state[2];
+  u32 d = state[3];
+  u32 e = state[4];
+
+  for (u32 i = 0; i < 80; i++)
+  {
+    u32 f, k;
+    if (i < 20)
+    {
+      f = d ^ (b & (c ^ d));
+      k = 0x5A827999;
+    }
+    else if (i < 40)
+    {
+      f = b ^ c ^ d;
+      k = 0x6ED9EBA1;
+    }
+    else if (i < 60)
+    {
+      f = (b & c) | (d & (b | c));
+      k = 0x8F1BBCDC;
+    }
+    else
+    {
+      f = b ^ c ^ d;
+      k = 0xCA62C1D6;
+    }
+
+    const u32 temp = SHA1Rotate(a, 5) + f + e + k + w[i];
+    e = d;
+    d = c;
+    c = SHA1Rotate(b, 30);
+    b = a;
+    a = temp;
+  }
+
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+  state[4] += e;
+}
+
+SHA1Digest::SHA1Digest()
+{
+  Reset();
+}
+
+void SHA1Digest::Reset()
+{
+  state[0] = 0x67452301;
+  state[1] = 0xEFCDAB89;
+  state[2] = 0x98BADCFE;
+  state[3] = 0x10325476;
+  state[4] = 0xC3D2E1F0;
+  count = 0;
+
+  std::memset(buffer, 0, sizeof(buffer));
+}
+
+void SHA1Digest::Update(const void* pData, u32 cbData)
+{
+  const u8* pByteData = reinterpret_cast<const u8*>(pData);
+  u32 used = static_cast<u32>(count & 63);
+  count += cbData;
+
+  /* Top up a partially filled block first */
+  if (used)
+  {
+    const u32 t = 64 - used;
+    if (cbData < t)
+    {
+      std::memcpy(buffer + used, pByteData, cbData);
+      return;
+    }
+
+    std::memcpy(buffer + used, pByteData, t);
+    SHA1Transform(state, buffer);
+    pByteData += t;
+    cbData -= t;
+  }
+
+  /* Process whole blocks straight from the input */
+  while (cbData >= 64)
+  {
+    SHA1Transform(state, pByteData);
+    pByteData += 64;
+    cbData -= 64;
+  }
+
+  std::memcpy(buffer, pByteData, cbData);
+}
+
+void SHA1Digest::Final(u8 Digest[DIGEST_SIZE])
+{
+  const u64 bit_count = count * 8;
+  u32 used = static_cast<u32>(count & 63);
+
+  /* Pad with a one bit, then zeros up to 56 mod 64 */
+  buffer[used++] = 0x80;
+  if (used > 56)
+  {
+    std::memset(buffer + used, 0, 64 - used);
+    SHA1Transform(state, buffer);
+    used = 0;
+  }
+  std::memset(buffer + used, 0, 56 - used);
+
+  /* Append length in bits, big endian */
+  for (u32 i = 0; i < 8; i++)
+    buffer[56 + i] = static_cast<u8>(bit_count >> (56 - i * 8));
+  SHA1Transform(state, buffer);
+
+  for (u32 i = 0; i < 5; i++)
+  {
+    Digest[i * 4] = static_cast<u8>(state[i] >> 24);
+    Digest[i * 4 + 1] = static_cast<u8>(state[i] >> 16);
+    Digest[i * 4 + 2] = static_cast<u8>(state[i] >> 8);
+    Digest[i * 4 + 3] = static_cast<u8>(state[i]);
+  }
+}
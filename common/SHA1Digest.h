@@ -0,0 +1,25 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+#include "Pcsx2Types.h"
+
+class SHA1Digest
+{
+public:
+  enum : u32
+  {
+    DIGEST_SIZE = 20
+  };
+
+  SHA1Digest();
+
+  void Update(const void* pData, u32 cbData);
+  void Final(u8 Digest[DIGEST_SIZE]);
+  void Reset();
+
+private:
+  u32 state[5];
+  u64 count;
+  u8 buffer[64];
+};
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
 // SPDX-License-Identifier: GPL-3.0+
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <csignal>
@@ -8,6 +9,8 @@
 #include <condition_variable>
 #include <mutex>
 #include <thread>
+#include <utility>
+#include <vector>
 
 #ifdef _WIN32
 #include "common/RedtapeWindows.h"
@@ -25,6 +28,7 @@
 #include "common/ProgressCallback.h"
 #include "common/SettingsWrapper.h"
 #include "common/StringUtil.h"
+#include "common/Timer.h"
 
 #include "pcsx2/PrecompiledHeader.h"
 
@@ -63,6 +67,8 @@ namespace GSRunner
 	static void SettingsOverride();
 	static bool ParseCommandLineArgs(int argc, char* argv[], VMBootParameters& params);
 	static void DumpStats();
+	static void UpdateBenchmark();
+	static bool WriteBenchmarkReport(const std::string& path);
 
 	static bool CreatePlatformWindow();
 	static void DestroyPlatformWindow();
@@ -118,6 +124,24 @@ static float s_perf_sum_gs_thread_time = 0.0f;
 static float s_perf_sum_gpu_time = 0.0f;
 static float s_perf_sum_gpu_usage = 0.0f;
 
+struct BenchmarkFrame
+{
+	u32 pass;
+	u32 frame;
+	u32 draws;
+	float frame_ms;
+	float draw_ms;
+	float max_draw_us;
+};
+
+static std::string s_benchmark_report;
+static std::vector<BenchmarkFrame> s_benchmark_frames;
+static std::vector<float> s_benchmark_draw_times;
+static std::vector<float> s_benchmark_frame_draw_times;
+static Common::Timer::Value s_benchmark_last_present = 0;
+static u32 s_benchmark_last_frame = 0;
+static u32 s_benchmark_pass = 0;
+
 bool GSRunner::InitializeConfig()
 {
 	EmuFolders::SetAppRoot();
@@ -311,6 +335,9 @@ void Host::BeginPresentFrame()
 
 		std::atomic_thread_fence(std::memory_order_release);
 	}
+
+	if (!s_benchmark_report.empty())
+		GSRunner::UpdateBenchmark();
 }
 
 void Host::RequestResizeHostDisplay(s32 width, s32 height)
@@ -511,6 +538,8 @@ static void PrintCommandLineHelp(const char* progname)
 	std::fprintf(stderr, "  -logfile <filename>: Writes emu log to filename.\n");
 	std::fprintf(stderr, "  -noshadercache: Disables the shader cache (useful for parallel runs).\n");
 	std::fprintf(stderr, "  -perf: Enable frame timing performance stats.\n");
+	std::fprintf(stderr, "  -benchmark <report>: Records per-frame and per-draw CPU time, and writes a report with\n"
+						 "    percentiles to the given .json or .csv file. Use with -loop and -renderer sw|null.\n");
 	std::fprintf(stderr, "  --: Signals that no more arguments will follow and the remaining\n"
 						 "    parameters make up the filename. Use when the filename contains\n"
 						 "    spaces or starts with a dash.\n");
@@ -684,6 +713,8 @@ bool GSRunner::ParseCommandLineArgs(int argc, char* argv[], VMBootParameters& pa
 #endif
 				else if (StringUtil::Strcasecmp(rname, "sw") == 0)
 					type = GSRendererType::SW;
+				else if (StringUtil::Strcasecmp(rname, "null") == 0)
+					type = GSRendererType::Null;
 				else
 				{
 					Console.Error("Unknown renderer '%s'", rname);
@@ -803,6 +834,19 @@ bool GSRunner::ParseCommandLineArgs(int argc, char* argv[], VMBootParameters& pa
 				s_perf_enable = true;
 				continue;
 			}
+			else if (CHECK_ARG_PARAM("-benchmark"))
+			{
+				s_benchmark_report = StringUtil::StripWhitespace(argv[++i]);
+				if (!StringUtil::EndsWithNoCase(s_benchmark_report, ".json") &&
+					!StringUtil::EndsWithNoCase(s_benchmark_report, ".csv"))
+				{
+					Console.Error("Benchmark report must be a .json or .csv file.");
+					return false;
+				}
+
+				Console.WriteLn(fmt::format("Writing benchmark report to {}", s_benchmark_report));
+				continue;
+			}
 			else if (CHECK_ARG("-debugdevice"))
 			{
 				Console.WriteLn("Enable debug device");
@@ -935,6 +979,152 @@ void GSRunner::DumpStats()
 	Console.WriteLn("============================================");
 }
 
+void GSRunner::UpdateBenchmark()
+{
+	// Runs on the GS thread at the start of each presented frame.
+	g_perfmon.TakeDrawTimes(&s_benchmark_frame_draw_times);
+
+	const Common::Timer::Value now = Common::Timer::GetCurrentValue();
+	const Common::Timer::Value last = std::exchange(s_benchmark_last_present, now);
+	if (s_dump_frame_number < s_benchmark_last_frame)
+		s_benchmark_pass++;
+	s_benchmark_last_frame = s_dump_frame_number;
+
+	// Nothing to measure the first frame against.
+	if (last == 0)
+		return;
+
+	BenchmarkFrame frame = {};
+	frame.pass = s_benchmark_pass;
+	frame.frame = s_dump_frame_number;
+	frame.draws = static_cast<u32>(s_benchmark_frame_draw_times.size());
+	frame.frame_ms = static_cast<float>(Common::Timer::ConvertValueToMilliseconds(now - last));
+	for (const float us : s_benchmark_frame_draw_times)
+	{
+		frame.draw_ms += us / 1000.0f;
+		frame.max_draw_us = std::max(frame.max_draw_us, us);
+	}
+
+	s_benchmark_frames.push_back(frame);
+	s_benchmark_draw_times.insert(s_benchmark_draw_times.end(), s_benchmark_frame_draw_times.begin(),
+		s_benchmark_frame_draw_times.end());
+}
+
+namespace
+{
+	struct BenchmarkSummary
+	{
+		size_t count;
+		double mean, p50, p90, p95, p99, max;
+	};
+} // namespace
+
+static BenchmarkSummary SummarizeBenchmark(std::vector<float> values)
+{
+	BenchmarkSummary summary = {};
+	summary.count = values.size();
+	if (values.empty())
+		return summary;
+
+	std::sort(values.begin(), values.end());
+
+	// Nearest-rank percentiles.
+	const auto percentile = [&values](double p) {
+		const size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * static_cast<double>(values.size())));
+		return static_cast<double>(values[std::clamp<size_t>(rank, 1, values.size()) - 1]);
+	};
+
+	double sum = 0.0;
+	for (const float value : values)
+		sum += value;
+
+	summary.mean = sum / static_cast<double>(values.size());
+	summary.p50 = percentile(50.0);
+	summary.p90 = percentile(90.0);
+	summary.p95 = percentile(95.0);
+	summary.p99 = percentile(99.0);
+	summary.max = values.back();
+	return summary;
+}
+
+bool GSRunner::WriteBenchmarkReport(const std::string& path)
+{
+	std::atomic_thread_fence(std::memory_order_acquire);
+
+	std::vector<float> frame_times;
+	std::vector<float> frame_draw_times;
+	frame_times.reserve(s_benchmark_frames.size());
+	frame_draw_times.reserve(s_benchmark_frames.size());
+	for (const BenchmarkFrame& frame : s_benchmark_frames)
+	{
+		frame_times.push_back(frame.frame_ms);
+		frame_draw_times.push_back(frame.draw_ms);
+	}
+
+	const BenchmarkSummary frame_summary = SummarizeBenchmark(std::move(frame_times));
+	const BenchmarkSummary frame_draw_summary = SummarizeBenchmark(std::move(frame_draw_times));
+	const BenchmarkSummary draw_summary = SummarizeBenchmark(s_benchmark_draw_times);
+
+	Console.WriteLn(fmt::format("======= BENCHMARK FOR {} FRAMES, {} DRAWS ========", frame_summary.count, draw_summary.count));
+	Console.WriteLn(fmt::format("@BENCH@ Frame Time: mean {:.3f} ms, p50 {:.3f} ms, p99 {:.3f} ms, max {:.3f} ms",
+		frame_summary.mean, frame_summary.p50, frame_summary.p99, frame_summary.max));
+	Console.WriteLn(fmt::format("@BENCH@ Draw Time: mean {:.3f} us, p50 {:.3f} us, p99 {:.3f} us, max {:.3f} us",
+		draw_summary.mean, draw_summary.p50, draw_summary.p99, draw_summary.max));
+	Console.WriteLn("============================================");
+
+	auto fp = FileSystem::OpenManagedCFile(path.c_str(), "wb");
+	if (!fp)
+	{
+		Console.ErrorFmt("Failed to open benchmark report {}", path);
+		return false;
+	}
+
+	static constexpr auto format_summary_csv = [](std::string_view name, const BenchmarkSummary& summary) {
+		return fmt::format("{},{},{:.4f},{:.4f},{:.4f},{:.4f},{:.4f},{:.4f}\n", name, summary.count, summary.mean,
+			summary.p50, summary.p90, summary.p95, summary.p99, summary.max);
+	};
+	static constexpr auto format_summary_json = [](const BenchmarkSummary& summary) {
+		return fmt::format("{{\"count\": {}, \"mean\": {:.4f}, \"p50\": {:.4f}, \"p90\": {:.4f}, \"p95\": {:.4f}, "
+						   "\"p99\": {:.4f}, \"max\": {:.4f}}}",
+			summary.count, summary.mean, summary.p50, summary.p90, summary.p95, summary.p99, summary.max);
+	};
+
+	std::string report;
+	if (StringUtil::EndsWithNoCase(path, ".csv"))
+	{
+		report += "metric,count,mean,p50,p90,p95,p99,max\n";
+		report += format_summary_csv("frame_time_ms", frame_summary);
+		report += format_summary_csv("frame_draw_time_ms", frame_draw_summary);
+		report += format_summary_csv("draw_time_us", draw_summary);
+	}
+	else
+	{
+		report += "{\n";
+		report += fmt::format("  \"renderer\": \"{}\",\n", Pcsx2Config::GSOptions::GetRendererName(EmuConfig.GS.Renderer));
+		report += fmt::format("  \"passes\": {},\n", s_benchmark_frames.empty() ? 0 : (s_benchmark_frames.back().pass + 1));
+		report += fmt::format("  \"frame_time_ms\": {},\n", format_summary_json(frame_summary));
+		report += fmt::format("  \"frame_draw_time_ms\": {},\n", format_summary_json(frame_draw_summary));
+		report += fmt::format("  \"draw_time_us\": {},\n", format_summary_json(draw_summary));
+		report += "  \"frames\": [";
+		for (size_t i = 0; i < s_benchmark_frames.size(); i++)
+		{
+			const BenchmarkFrame& frame = s_benchmark_frames[i];
+			report += fmt::format("{}\n    {{\"pass\": {}, \"frame\": {}, \"draws\": {}, \"frame_ms\": {:.4f}, "
+								  "\"draw_ms\": {:.4f}, \"max_draw_us\": {:.4f}}}",
+				(i > 0) ? "," : "", frame.pass, frame.frame, frame.draws, frame.frame_ms, frame.draw_ms, frame.max_draw_us);
+		}
+		report += "\n  ]\n}\n";
+	}
+
+	if (std::fwrite(report.data(), report.size(), 1, fp.get()) != 1)
+	{
+		Console.ErrorFmt("Failed to write benchmark report {}", path);
+		return false;
+	}
+
+	return true;
+}
+
 #ifdef _WIN32
 // We can't handle unicode in filenames if we don't use wmain on Win32.
 #define main real_main
@@ -950,6 +1140,10 @@ static void CPUThreadMain(VMBootParameters* params, std::atomic<int>* ret)
 		VMManager::ApplySettings();
 		GSDumpReplayer::SetIsDumpRunner(true);
 
+		// GS thread isn't drawing yet, so this is safe to flip from here.
+		if (!s_benchmark_report.empty())
+			g_perfmon.SetDrawTimingEnabled(true);
+
 		if (VMManager::Initialize(*params) == VMBootResult::StartupSuccess)
 		{
 			// run until end
@@ -964,7 +1158,8 @@ static void CPUThreadMain(VMBootParameters* params, std::atomic<int>* ret)
 				VMManager::Execute();
 			VMManager::Shutdown(false);
 			GSRunner::DumpStats();
-			ret->store(EXIT_SUCCESS);
+			if (s_benchmark_report.empty() || GSRunner::WriteBenchmarkReport(s_benchmark_report))
+				ret->store(EXIT_SUCCESS);
 		}
 	}
 
@@ -225,6 +225,8 @@ void GameSummaryWidget::populateTrackList(const GameList::Entry* entry)
 		AddColumn(tr("Sectors"));
 		AddColumn(tr("Size"));
 		AddColumn(tr("MD5"));
+		AddColumn(tr("SHA-1"));
+		AddColumn(tr("CRC32"));
 		AddColumn(tr("Status"));
 	}
 	else
@@ -233,6 +235,8 @@ void GameSummaryWidget::populateTrackList(const GameList::Entry* entry)
 		AddColumn(tr("Sectors"));
 		AddColumn(tr("Size"));
 		AddColumn(tr("MD5"));
+		AddColumn(tr("SHA-1"));
+		AddColumn(tr("CRC32"));
 		AddColumn(tr("Status"));
 	}
 
@@ -250,7 +254,9 @@ void GameSummaryWidget::populateTrackList(const GameList::Entry* entry)
 			SetColumn(row, 3, tr("%1").arg(track.sectors));
 			SetColumn(row, 4, tr("%1").arg(track.size));
 			SetColumn(row, 5, tr("<not computed>"));
-			SetColumn(row, 6, QString());
+			SetColumn(row, 6, tr("<not computed>"));
+			SetColumn(row, 7, tr("<not computed>"));
+			SetColumn(row, 8, QString());
 		}
 		else
 		{
@@ -258,14 +264,16 @@ void GameSummaryWidget::populateTrackList(const GameList::Entry* entry)
 			SetColumn(row, 2, tr("%1").arg(track.sectors));
 			SetColumn(row, 3, tr("%1").arg(track.size));
 			SetColumn(row, 4, tr("<not computed>"));
-			SetColumn(row, 5, QString());
+			SetColumn(row, 5, tr("<not computed>"));
+			SetColumn(row, 6, tr("<not computed>"));
+			SetColumn(row, 7, QString());
 		}
 	}
 
 	if (hasher.IsCD())
-		QtUtils::ResizeColumnsForTableView(m_ui.tracks, {20, 60, 70, 70, 100, 220, 40});
+		QtUtils::ResizeColumnsForTableView(m_ui.tracks, {20, 60, 70, 70, 100, 220, 270, 70, 40});
 	else
-		QtUtils::ResizeColumnsForTableView(m_ui.tracks, {20, 100, 100, 100, 220, 40});
+		QtUtils::ResizeColumnsForTableView(m_ui.tracks, {20, 100, 100, 100, 220, 270, 70, 40});
 }
 
 void GameSummaryWidget::onVerifyClicked()
@@ -286,6 +294,9 @@ void GameSummaryWidget::onVerifyClicked()
 		return;
 	}
 
+	// SHA-1 and CRC32 are only shown, Redump matching uses the MD5. They're computed in the same pass.
+	hasher.SetExtraDigests(IsoHasher::DIGEST_SHA1 | IsoHasher::DIGEST_CRC32);
+
 	QtModalProgressCallback callback(this);
 	hasher.ComputeHashes(&callback);
 	if (callback.IsCancelled())
@@ -325,13 +336,18 @@ void GameSummaryWidget::onVerifyClicked()
 	for (u32 i = 0; i < hasher.GetTrackCount(); i++)
 	{
 		QTableWidgetItem* const hash_item = m_ui.tracks->item(row, hash_column);
-		QTableWidgetItem* const status_item = m_ui.tracks->item(row, hash_column + 1);
+		QTableWidgetItem* const sha1_item = m_ui.tracks->item(row, hash_column + 1);
+		QTableWidgetItem* const crc32_item = m_ui.tracks->item(row, hash_column + 2);
+		QTableWidgetItem* const status_item = m_ui.tracks->item(row, hash_column + 3);
 
+		const IsoHasher::Track& track = hasher.GetTrack(i);
 		const bool result = val_results[i];
 		const QBrush brush(result ? QColor(0, 200, 0) : QColor(200, 0, 0));
 
-		hash_item->setText(QString::fromStdString(hasher.GetTrack(i).hash));
+		hash_item->setText(QString::fromStdString(track.hash));
 		hash_item->setForeground(brush);
+		sha1_item->setText(QString::fromStdString(track.sha1));
+		crc32_item->setText(QString::fromStdString(track.crc32));
 		status_item->setText(result ? QStringLiteral("\u2713") : QStringLiteral("\u2715"));
 		status_item->setForeground(brush);
 		row++;
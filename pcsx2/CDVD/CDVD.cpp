@@ -574,15 +574,12 @@ static std::string ExecutablePathToSerial(const std::string& path)
 	return serial;
 }
 
-void cdvdGetDiscInfo(std::string* out_serial, std::string* out_elf_path, std::string* out_version, u32* out_crc,
-	CDVDDiscType* out_disc_type)
+static void GetDiscInfo(IsoReader& isor, bool isor_opened, Error& error, std::string* out_serial, std::string* out_elf_path,
+	std::string* out_version, u32* out_crc, CDVDDiscType* out_disc_type)
 {
-	Error error;
-	IsoReader isor;
-
 	std::string elfpath, version;
 	CDVDDiscType disc_type = CDVDDiscType::Other;
-	if (!isor.Open(&error) || (disc_type = GetPS2ElfName(isor, &elfpath, &version, &error)) == CDVDDiscType::Other)
+	if (!isor_opened || (disc_type = GetPS2ElfName(isor, &elfpath, &version, &error)) == CDVDDiscType::Other)
 		Console.Error(fmt::format("Failed to get ELF name: {}", error.GetDescription()));
 
 	// Don't bother parsing it if we don't need the CRC.
@@ -618,6 +615,24 @@ void cdvdGetDiscInfo(std::string* out_serial, std::string* out_elf_path, std::st
 		*out_disc_type = disc_type;
 }
 
+void cdvdGetDiscInfo(std::string* out_serial, std::string* out_elf_path, std::string* out_version, u32* out_crc,
+	CDVDDiscType* out_disc_type)
+{
+	Error error;
+	IsoReader isor;
+	const bool isor_opened = isor.Open(&error);
+	GetDiscInfo(isor, isor_opened, error, out_serial, out_elf_path, out_version, out_crc, out_disc_type);
+}
+
+void cdvdGetDiscInfo(InputIsoFile* iso, std::string* out_serial, std::string* out_elf_path, std::string* out_version,
+	u32* out_crc, CDVDDiscType* out_disc_type)
+{
+	Error error;
+	IsoReader isor;
+	const bool isor_opened = isor.Open(iso, &error);
+	GetDiscInfo(isor, isor_opened, error, out_serial, out_elf_path, out_version, out_crc, out_disc_type);
+}
+
 void cdvdReadKey(u8, u16, u32 arg2, u8* key)
 {
 	const std::string DiscSerial = VMManager::GetDiscSerial();
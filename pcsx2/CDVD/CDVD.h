@@ -11,6 +11,7 @@
 
 class Error;
 class ElfObject;
+class InputIsoFile;
 class IsoReader;
 
 #define btoi(b) ((b) / 16 * 10 + (b) % 16) /* BCD to u_char */
@@ -181,6 +182,8 @@ extern void cdvdWrite(u8 key, u8 rt);
 
 extern void cdvdGetDiscInfo(std::string* out_serial, std::string* out_elf_path, std::string* out_version, u32* out_crc,
 	CDVDDiscType* out_disc_type);
+extern void cdvdGetDiscInfo(InputIsoFile* iso, std::string* out_serial, std::string* out_elf_path, std::string* out_version,
+	u32* out_crc, CDVDDiscType* out_disc_type);
 extern u32 cdvdGetElfCRC(const std::string& path);
 extern bool cdvdLoadElf(ElfObject* elfo, const std::string_view elfpath, bool isPSXElf, Error* error);
 extern bool cdvdLoadDiscElf(ElfObject* elfo, IsoReader& isor, const std::string_view elfpath, bool isPSXElf, Error* error);
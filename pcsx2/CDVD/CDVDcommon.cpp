@@ -69,10 +69,9 @@ static void CheckNullCDVD()
 //////////////////////////////////////////////////////////////////////////////////////////
 // Disk Type detection stuff (from cdvdGigaherz)
 //
-static int CheckDiskTypeFS(int baseType)
+static int CheckDiskTypeFS(IsoReader& isor, bool isor_opened, int baseType)
 {
-	IsoReader isor;
-	if (isor.Open())
+	if (isor_opened)
 	{
 		std::vector<u8> data;
 		if (isor.ReadFile("SYSTEM.CNF", &data))
@@ -205,7 +204,9 @@ static int FindDiskType(int mType)
 
 	if (dataTracks > 0)
 	{
-		iCDType = CheckDiskTypeFS(iCDType);
+		IsoReader isor;
+		const bool isor_opened = isor.Open();
+		iCDType = CheckDiskTypeFS(isor, isor_opened, iCDType);
 	}
 
 	if (audioTracks > 0)
@@ -532,6 +533,27 @@ void DoCDVDresetDiskTypeCache()
 	diskTypeCached = -1;
 }
 
+s32 cdvdDetectIsoDiskType(InputIsoFile* iso)
+{
+	// Same as FindDiskType() for the ISO backend, which always reports a single data track.
+	// Dual layer detection is skipped, it doesn't change the result of the file system check.
+	int base_type = CDVD_TYPE_DETCTDVDS;
+	if (iso->GetBlockCount() <= 452849)
+	{
+		u8 raw[CD_FRAMESIZE_RAW];
+		if (iso->ReadSync(raw, 16) >= 0)
+		{
+			const u8* sector = raw + 24;
+			if (*(u16*)(sector + 166) == *(u16*)(sector + 171))
+				base_type = CDVD_TYPE_DETCTCD;
+		}
+	}
+
+	IsoReader isor;
+	const bool isor_opened = isor.Open(iso);
+	return CheckDiskTypeFS(isor, isor_opened, base_type);
+}
+
 ////////////////////////////////////////////////////////
 //
 // CDVD null interface for Run BIOS menu
@@ -15,14 +15,67 @@
 
 #include "fmt/format.h"
 
-#define GZIP_ID "PCSX2.index.gzip.v1|"
+#define GZIP_ID_V1 "PCSX2.index.gzip.v1|"
+#define GZIP_ID "PCSX2.index.gzip.v2|"
 #define GZIP_ID_LEN (sizeof(GZIP_ID) - 1) /* sizeof includes the \0 terminator */
+static_assert(sizeof(GZIP_ID_V1) == sizeof(GZIP_ID));
 
-// File format is:
+// v2 file format is:
 // - [GZIP_ID_LEN] GZIP_ID (no \0)
+// - [sizeof(GzipIndexHeader)] header, describing the index and the file it was built from
+// - [rest] the indexed data points, mapped directly from disk
+// The points are only touched when seeking to them, so with the file mapped, opening only
+// reads the pages we actually need, instead of the whole (32KB per point) index.
+struct GzipIndexHeader
+{
+	u32 points;
+	s32 span;
+	s64 uncompressed_size;
+	s64 source_size; // size of the compressed file, to detect stale indices
+	s64 source_mtime; // modification time of the compressed file
+};
+
+// v1 file format is:
+// - [GZIP_ID_LEN] GZIP_ID_V1 (no \0)
 // - [sizeof(Access)] index (should be allocated, contains various sizes)
 // - [rest] the indexed data points (should be allocated, index->list should then point to it)
-static Access* ReadIndexFromFile(const char* filename)
+static Access* ReadLegacyIndexFromFile(std::FILE* fp, s64 size, const char* filename)
+{
+	Access* const index = static_cast<Access*>(std::malloc(sizeof(Access)));
+	const s64 datasize = size - GZIP_ID_LEN - sizeof(Access);
+	if (std::fread(index, sizeof(Access), 1, fp) != 1 ||
+		datasize != static_cast<s64>(index->have) * static_cast<s64>(sizeof(Point)))
+	{
+		ERROR_LOG("Unexpected size of gzip index: '{}'.", filename);
+		std::free(index);
+		return nullptr;
+	}
+
+	char* buffer = static_cast<char*>(std::malloc(datasize));
+	if (std::fread(buffer, datasize, 1, fp) != 1)
+	{
+		ERROR_LOG("Failed read of gzip index: '{}'.", filename);
+		std::free(buffer);
+		std::free(index);
+		return nullptr;
+	}
+
+	index->list = reinterpret_cast<Point*>(buffer); // adjust list pointer
+	return index;
+}
+
+static bool GetSourceStamp(std::FILE* src, s64* size, s64* mtime)
+{
+	FILESYSTEM_STAT_DATA sd;
+	if (!FileSystem::StatFile(src, &sd))
+		return false;
+
+	*size = sd.Size;
+	*mtime = static_cast<s64>(sd.ModificationTime);
+	return true;
+}
+
+static Access* ReadIndexFromFile(const char* filename, std::FILE* src, std::span<const u8>* mapping)
 {
 	auto fp = FileSystem::OpenManagedCFile(filename, "rb");
 	if (!fp)
@@ -36,55 +89,80 @@ static Access* ReadIndexFromFile(const char* filename)
 	}
 
 	char fileId[GZIP_ID_LEN + 1] = {0};
-	if (std::fread(fileId, GZIP_ID_LEN, 1, fp.get()) != 1 || std::memcmp(fileId, GZIP_ID, 4) != 0)
+	if (std::fread(fileId, GZIP_ID_LEN, 1, fp.get()) != 1)
 	{
 		ERROR_LOG("Incompatible gzip index: '{}'", filename);
 		return nullptr;
 	}
 
-	Access* const index = static_cast<Access*>(std::malloc(sizeof(Access)));
-	const s64 datasize = size - GZIP_ID_LEN - sizeof(Access);
-	if (std::fread(index, sizeof(Access), 1, fp.get()) != 1 ||
-		datasize != static_cast<s64>(index->have) * static_cast<s64>(sizeof(Point)))
+	if (std::memcmp(fileId, GZIP_ID_V1, GZIP_ID_LEN) == 0)
+		return ReadLegacyIndexFromFile(fp.get(), size, filename);
+
+	GzipIndexHeader header;
+	if (std::memcmp(fileId, GZIP_ID, GZIP_ID_LEN) != 0 || std::fread(&header, sizeof(header), 1, fp.get()) != 1)
+	{
+		ERROR_LOG("Incompatible gzip index: '{}'", filename);
+		return nullptr;
+	}
+
+	const s64 datasize = size - GZIP_ID_LEN - sizeof(header);
+	if (header.points == 0 || header.span <= 0 || datasize != static_cast<s64>(header.points) * static_cast<s64>(sizeof(Point)))
 	{
 		ERROR_LOG("Unexpected size of gzip index: '{}'.", filename);
-		std::free(index);
-		return 0;
+		return nullptr;
 	}
 
-	char* buffer = static_cast<char*>(std::malloc(datasize));
-	if (std::fread(buffer, datasize, 1, fp.get()) != 1)
+	s64 source_size, source_mtime;
+	if (!GetSourceStamp(src, &source_size, &source_mtime) ||
+		source_size != header.source_size || source_mtime != header.source_mtime)
 	{
-		ERROR_LOG("Failed read of gzip index: '{}'.");
-		std::free(buffer);
-		std::free(index);
-		return 0;
+		WARNING_LOG("Gzip index '{}' is out of date, it will be rebuilt.", filename);
+		return nullptr;
 	}
 
-	index->list = reinterpret_cast<Point*>(buffer); // adjust list pointer
+	const std::span<const u8> data = FileSystem::MapBinaryFileForRead(fp.get());
+	if (data.size() != static_cast<size_t>(size))
+	{
+		ERROR_LOG("Failed to map gzip index: '{}'.", filename);
+		if (!data.empty())
+			FileSystem::UnmapFile(data);
+		return nullptr;
+	}
+
+	Access* const index = static_cast<Access*>(std::malloc(sizeof(Access)));
+	index->have = static_cast<int>(header.points);
+	index->size = index->have;
+	index->span = header.span;
+	index->uncompressed_size = header.uncompressed_size;
+	index->list = reinterpret_cast<Point*>(const_cast<u8*>(data.data()) + GZIP_ID_LEN + sizeof(header));
+	*mapping = data;
 	return index;
 }
 
-static void WriteIndexToFile(Access* index, const char* filename)
+static void WriteIndexToFile(Access* index, std::FILE* src, const char* filename)
 {
-	auto fp = FileSystem::OpenManagedCFile(filename, "wb");
-	if (!fp)
+	GzipIndexHeader header = {};
+	header.points = static_cast<u32>(index->have);
+	header.span = index->span;
+	header.uncompressed_size = index->uncompressed_size;
+	if (!GetSourceStamp(src, &header.source_size, &header.source_mtime))
+	{
+		ERROR_LOG("Warning: Can't stat source file, not saving gzip index: '{}'", filename);
 		return;
+	}
 
-	bool success = (std::fwrite(GZIP_ID, GZIP_ID_LEN, 1, fp.get()) == 1);
-
-	Point* tmp = index->list;
-	index->list = 0; // current pointer is useless on disk, normalize it as 0.
-	std::fwrite((char*)index, sizeof(Access), 1, fp.get());
-	index->list = tmp;
-
-	success = success && (std::fwrite((char*)index->list, sizeof(Point) * index->have, 1, fp.get()) == 1);
-
-	// Verify
+	const bool success = FileSystem::WriteAtomicRenamedFile(filename, [index, &header](std::FILE* fp) {
+		return std::fwrite(GZIP_ID, GZIP_ID_LEN, 1, fp) == 1 && std::fwrite(&header, sizeof(header), 1, fp) == 1 &&
+			   std::fwrite(index->list, sizeof(Point) * index->have, 1, fp) == 1;
+	});
 	if (!success)
+	{
 		ERROR_LOG("Warning: Can't write index file to disk: '{}'", filename);
+	}
 	else
+	{
 		INFO_LOG("Gzip quick access index file saved to disk: '{}'", filename);
+	}
 }
 
 static const char* INDEX_TEMPLATE_KEY = "$(f)";
@@ -148,7 +226,7 @@ bool GzippedFileReader::LoadOrCreateIndex(Error* error)
 		return false;
 	}
 
-	if ((m_index = ReadIndexFromFile(indexfile.c_str())) != nullptr)
+	if ((m_index = ReadIndexFromFile(indexfile.c_str(), m_src, &m_index_mapping)) != nullptr)
 	{
 		INFO_LOG("Gzip quick access index read from disk: '{}'", indexfile);
 		return true;
@@ -166,7 +244,7 @@ bool GzippedFileReader::LoadOrCreateIndex(Error* error)
 	if (len >= 0)
 	{
 		m_index = index;
-		WriteIndexToFile(m_index, indexfile.c_str());
+		WriteIndexToFile(m_index, m_src, indexfile.c_str());
 	}
 	else
 	{
@@ -208,7 +286,17 @@ void GzippedFileReader::Close2()
 
 	if (m_index)
 	{
-		free_index(m_index);
+		if (!m_index_mapping.empty())
+		{
+			// List points into the mapped file.
+			FileSystem::UnmapFile(m_index_mapping);
+			m_index_mapping = {};
+			std::free(m_index);
+		}
+		else
+		{
+			free_index(m_index);
+		}
 		m_index = nullptr;
 	}
 }
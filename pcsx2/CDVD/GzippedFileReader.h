@@ -6,6 +6,8 @@
 #include "CDVD/ThreadedFileReader.h"
 #include "zlib_indexed.h"
 
+#include <span>
+
 class GzippedFileReader final : public ThreadedFileReader
 {
 	DeclareNoncopyableObject(GzippedFileReader);
@@ -32,6 +34,7 @@ private:
 	bool LoadOrCreateIndex(Error* error);
 
 	Access* m_index = nullptr; // Quick access index
+	std::span<const u8> m_index_mapping; // Mapped index file, if the index was loaded from disk
 
 	std::FILE* m_src = nullptr;
 
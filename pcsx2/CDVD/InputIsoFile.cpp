@@ -194,6 +194,7 @@ bool InputIsoFile::Open(std::string srcfile, Error* error)
 	Close();
 	m_filename = std::move(srcfile);
 	m_reader = GetFileReader(m_filename);
+	m_reader->SetReadaheadBuffers(static_cast<u32>(std::max(EmuConfig.CdvdReadaheadBuffers, 0)));
 	if (!m_reader->Open(m_filename, error))
 	{
 		m_reader.reset();
@@ -2,15 +2,27 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "CDVD/CDVDcommon.h"
+#include "CDVD/IsoFileFormats.h"
 #include "CDVD/IsoHasher.h"
 #include "Host.h"
 
 #include "common/Error.h"
 #include "common/MD5Digest.h"
+#include "common/SHA1Digest.h"
+#include "common/Threading.h"
 
 #include "fmt/format.h"
+#include "fmt/ranges.h"
 
 #include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include <zlib.h>
 
 IsoHasher::IsoHasher() = default;
 
@@ -38,18 +50,16 @@ bool IsoHasher::Open(std::string iso_path, Error* error)
 {
 	Close();
 
-	m_is_locked = cdvdLock(error);
-	if (!m_is_locked)
-		return false;
-
-	CDVDsys_SetFile(CDVD_SourceType::Iso, std::move(iso_path));
-	CDVDsys_ChangeSource(CDVD_SourceType::Iso);
-
-	m_is_open = DoCDVDopen(error);
-	if (!m_is_open)
+	// Reads from its own copy of the image rather than the CDVD source, so it doesn't get
+	// in the way of a running game, and several images can be hashed at the same time.
+	m_iso = std::make_unique<InputIsoFile>();
+	if (!m_iso->Open(std::move(iso_path), error))
+	{
+		m_iso.reset();
 		return false;
+	}
 
-	const s32 type = DoCDVDdetectDiskType();
+	const s32 type = cdvdDetectIsoDiskType(m_iso.get());
 	switch (type)
 	{
 		case CDVD_TYPE_PSCD:
@@ -65,60 +75,30 @@ bool IsoHasher::Open(std::string iso_path, Error* error)
 
 		default:
 			Error::SetString(error, fmt::format("Unknown CDVD disk type {}", type));
+			Close();
 			return false;
 	}
 
-	cdvdTN tn;
-	if (CDVD->getTN(&tn) < 0)
-	{
-		Error::SetString(error, "Failed to get track count.");
-		return false;
-	}
-
-	for (u8 track = tn.strack; track <= tn.etrack; track++)
-	{
-		cdvdTD td, next_td;
-		if (CDVD->getTD(track, &td) < 0 || CDVD->getTD((track == tn.etrack) ? 0 : (track + 1), &next_td) < 0)
-		{
-			Error::SetString(error, fmt::format("Failed to get track range for {}", static_cast<unsigned>(track)));
-			return false;
-		}
-
-		// sanity check..
-		if (next_td.lsn < td.lsn)
-		{
-			Error::SetString(error,
-				fmt::format("Invalid track range for {} ({},{})", static_cast<unsigned>(track), td.lsn, next_td.lsn));
-			return false;
-		}
-
-		Track strack;
-		strack.number = track;
-		strack.type = td.type;
-		strack.start_lsn = td.lsn;
-		strack.sectors = next_td.lsn - td.lsn;
-		strack.size = static_cast<u64>(strack.sectors) * (m_is_cd ? 2352 : 2048);
-		m_tracks.push_back(std::move(strack));
-	}
+	// Images are a single data track, same as the ISO CDVD source reports.
+	Track strack;
+	strack.number = 1;
+	strack.type = CDVD_MODE1_TRACK;
+	strack.start_lsn = 0;
+	strack.sectors = m_iso->GetBlockCount();
+	strack.size = static_cast<u64>(strack.sectors) * (m_is_cd ? 2352 : 2048);
+	m_tracks.push_back(std::move(strack));
 
 	return true;
 }
 
 void IsoHasher::Close()
 {
-	if (!m_is_locked)
-		return;
-
-	cdvdUnlock();
-	m_is_locked = false;
-
-	if (!m_is_open)
+	if (!m_iso)
 		return;
 
-	DoCDVDclose();
+	m_iso.reset();
 	m_tracks.clear();
 	m_is_cd = false;
-	m_is_open = false;
 }
 
 void IsoHasher::ComputeHashes(ProgressCallback* callback)
@@ -150,12 +130,35 @@ void IsoHasher::ComputeHashes(ProgressCallback* callback)
 	callback->SetProgressValue(GetTrackCount());
 }
 
+bool IsoHasher::ReadSector(u8* dst, u32 lsn, u8* raw_buffer)
+{
+	// Same layout as the ISO CDVD source's 2352 byte reads for CDs, and 2048 byte reads for DVDs.
+	if (m_iso->ReadSync(raw_buffer, lsn) < 0)
+		return false;
+
+	if (m_is_cd)
+		std::memcpy(dst, raw_buffer, 2352);
+	else
+		std::memcpy(dst, raw_buffer + 24, 2048);
+
+	return true;
+}
+
 bool IsoHasher::ComputeTrackHash(Track& track, ProgressCallback* callback)
 {
-	// use 2048 byte reads for DVDs, otherwise 2352 raw.
-	const int read_mode = m_is_cd ? CDVD_MODE_2352 : CDVD_MODE_2048;
+	// Sectors are read and decompressed on this thread, while each digest runs on its own thread.
+	// Chunks go around a small ring, and are only refilled once every digest is done with them.
+	static constexpr u32 CHUNK_SECTORS = 256;
+	static constexpr u32 NUM_CHUNKS = 4;
+
+	struct Chunk
+	{
+		std::vector<u8> data;
+		u32 size = 0;
+		u32 pending = 0;
+	};
+
 	const u32 sector_size = m_is_cd ? 2352 : 2048;
-	std::vector<u8> sector_buffer(sector_size);
 
 	const u32 update_interval = std::max<u32>(track.sectors / 100u, 1u);
 	callback->SetStatusText(
@@ -163,23 +166,103 @@ bool IsoHasher::ComputeTrackHash(Track& track, ProgressCallback* callback)
 	callback->SetProgressRange(track.sectors);
 
 	MD5Digest md5;
-	for (u32 i = 0; i < track.sectors; i++)
+	SHA1Digest sha1;
+	uLong crc = crc32(0, Z_NULL, 0);
+
+	std::vector<std::function<void(const u8*, u32)>> digests;
+	digests.push_back([&md5](const u8* data, u32 size) { md5.Update(data, size); });
+	if (m_extra_digests & DIGEST_SHA1)
+		digests.push_back([&sha1](const u8* data, u32 size) { sha1.Update(data, size); });
+	if (m_extra_digests & DIGEST_CRC32)
+		digests.push_back([&crc](const u8* data, u32 size) { crc = crc32(crc, data, size); });
+
+	std::mutex mutex;
+	std::condition_variable cv;
+	std::array<Chunk, NUM_CHUNKS> chunks;
+	for (Chunk& chunk : chunks)
+		chunk.data.resize(CHUNK_SECTORS * sector_size);
+	u32 chunks_produced = 0;
+	bool finished = false;
+
+	std::vector<std::thread> threads;
+	threads.reserve(digests.size());
+	for (const auto& digest : digests)
+	{
+		threads.emplace_back([&mutex, &cv, &chunks, &chunks_produced, &finished, &digest]() {
+			Threading::SetNameOfCurrentThread("ISO Hasher");
+
+			std::unique_lock lock(mutex);
+			for (u32 consumed = 0;; consumed++)
+			{
+				cv.wait(lock, [&]() { return (chunks_produced > consumed || finished); });
+				if (chunks_produced <= consumed)
+					break;
+
+				Chunk& chunk = chunks[consumed % NUM_CHUNKS];
+				lock.unlock();
+				digest(chunk.data.data(), chunk.size);
+				lock.lock();
+
+				if (--chunk.pending == 0)
+					cv.notify_all();
+			}
+		});
+	}
+
+	bool okay = true;
+	u8 raw_buffer[CD_FRAMESIZE_RAW] = {};
+	for (u32 sector = 0; sector < track.sectors;)
 	{
 		if (callback->IsCancelled())
-			return false;
+		{
+			okay = false;
+			break;
+		}
 
-		const u32 lsn = track.start_lsn + i;
-		if (DoCDVDreadSector(sector_buffer.data(), lsn, read_mode) != 0)
+		// Only this thread changes the produced count, so it's fine to look at without the lock.
+		Chunk& chunk = chunks[chunks_produced % NUM_CHUNKS];
 		{
-			callback->DisplayFormattedModalError("Read error at LSN %u", lsn);
-			return false;
+			std::unique_lock lock(mutex);
+			cv.wait(lock, [&chunk]() { return (chunk.pending == 0); });
+		}
+
+		const u32 count = std::min(CHUNK_SECTORS, track.sectors - sector);
+		for (u32 i = 0; i < count; i++)
+		{
+			const u32 lsn = track.start_lsn + sector + i;
+			if (!ReadSector(chunk.data.data() + i * sector_size, lsn, raw_buffer))
+			{
+				callback->DisplayFormattedModalError("Read error at LSN %u", lsn);
+				okay = false;
+				break;
+			}
 		}
+		if (!okay)
+			break;
 
-		md5.Update(sector_buffer.data(), sector_size);
+		{
+			std::unique_lock lock(mutex);
+			chunk.size = count * sector_size;
+			chunk.pending = static_cast<u32>(digests.size());
+			chunks_produced++;
+		}
+		cv.notify_all();
+
+		if (((sector + count) / update_interval) != (sector / update_interval))
+			callback->SetProgressValue(sector + count);
+		sector += count;
+	}
 
-		if ((i % update_interval) == 0)
-			callback->SetProgressValue(i);
+	{
+		std::unique_lock lock(mutex);
+		finished = true;
 	}
+	cv.notify_all();
+	for (std::thread& thread : threads)
+		thread.join();
+
+	if (!okay)
+		return false;
 
 	u8 digest[16];
 	md5.Final(digest);
@@ -188,6 +271,16 @@ bool IsoHasher::ComputeTrackHash(Track& track, ProgressCallback* callback)
 			digest[0], digest[1], digest[2], digest[3], digest[4], digest[5], digest[6], digest[7], digest[8],
 			digest[9], digest[10], digest[11], digest[12], digest[13], digest[14], digest[15]);
 
+	if (m_extra_digests & DIGEST_SHA1)
+	{
+		u8 sha1_digest[SHA1Digest::DIGEST_SIZE];
+		sha1.Final(sha1_digest);
+		track.sha1 = fmt::format("{:02x}", fmt::join(sha1_digest, ""));
+	}
+
+	if (m_extra_digests & DIGEST_CRC32)
+		track.crc32 = fmt::format("{:08x}", static_cast<u32>(crc));
+
 	callback->SetProgressValue(track.sectors);
 	return true;
 }
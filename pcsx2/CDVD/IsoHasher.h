@@ -6,14 +6,22 @@
 #include "common/Pcsx2Defs.h"
 #include "common/ProgressCallback.h"
 
+#include <memory>
 #include <string>
 #include <vector>
 
 class Error;
+class InputIsoFile;
 
 class IsoHasher
 {
 public:
+	enum : u32
+	{
+		DIGEST_SHA1 = (1u << 0),
+		DIGEST_CRC32 = (1u << 1),
+	};
+
 	struct Track
 	{
 		u32 number;
@@ -21,7 +29,9 @@ public:
 		u32 start_lsn;
 		u32 sectors;
 		u64 size;
-		std::string hash;
+		std::string hash; // MD5
+		std::string sha1;
+		std::string crc32;
 	};
 
 public:
@@ -38,16 +48,20 @@ public:
 	const std::vector<Track>& GetTracks() const { return m_tracks; }
 	bool IsCD() const { return m_is_cd; }
 
+	/// Digests to compute in the same pass as the MD5, from the DIGEST_ flags.
+	void SetExtraDigests(u32 digests) { m_extra_digests = digests; }
+
 	bool Open(std::string iso_path, Error* error = nullptr);
 	void Close();
 
 	void ComputeHashes(ProgressCallback* callback = ProgressCallback::NullProgressCallback);
 
 private:
+	bool ReadSector(u8* dst, u32 lsn, u8* raw_buffer);
 	bool ComputeTrackHash(Track& track, ProgressCallback* callback);
 
+	std::unique_ptr<InputIsoFile> m_iso;
 	std::vector<Track> m_tracks;
-	bool m_is_locked = false;
-	bool m_is_open = false;
+	u32 m_extra_digests = 0;
 	bool m_is_cd = false;
 };
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "CDVD/CDVDcommon.h"
+#include "CDVD/IsoFileFormats.h"
 #include "CDVD/IsoReader.h"
 
 #include "common/Assertions.h"
@@ -31,8 +32,28 @@ bool IsoReader::Open(Error* error)
 	return true;
 }
 
+bool IsoReader::Open(InputIsoFile* iso, Error* error)
+{
+	m_iso = iso;
+	return Open(error);
+}
+
 bool IsoReader::ReadSector(u8* buf, u32 lsn, Error* error)
 {
+	if (m_iso)
+	{
+		// Same layout as the ISO CDVD backend, the user data of a raw sector starts after the sync and header.
+		u8 raw[CD_FRAMESIZE_RAW];
+		if (lsn >= m_iso->GetBlockCount() || m_iso->ReadSync(raw, lsn) < 0)
+		{
+			Error::SetString(error, fmt::format("Failed to read sector LSN #{}", lsn));
+			return false;
+		}
+
+		std::memcpy(buf, raw + 24, SECTOR_SIZE);
+		return true;
+	}
+
 	if (DoCDVDreadSector(buf, lsn, CDVD_MODE_2048) != 0)
 	{
 		Error::SetString(error, fmt::format("Failed to read sector LSN #{}", lsn));
@@ -4,6 +4,7 @@
 #include "ThreadedFileReader.h"
 #include "Host.h"
 
+#include "common/Console.h"
 #include "common/Error.h"
 #include "common/HostSys.h"
 #include "common/Path.h"
@@ -69,6 +70,7 @@ void ThreadedFileReader::Loop()
 
 		u64 requestOffset;
 		u32 requestSize;
+		const u32 readaheadDepth = ReadaheadDepth();
 
 		bool ok = true;
 		m_running = true;
@@ -114,7 +116,7 @@ void ThreadedFileReader::Loop()
 					if (buf->offset + bufsize != chunk.offset || chunk.length + bufsize > buf->cap)
 					{
 						buffersFilled++;
-						if (buffersFilled >= 2)
+						if (buffersFilled >= static_cast<int>(readaheadDepth))
 							break;
 						buf = GetBlockPtr(chunk);
 					}
@@ -143,13 +145,13 @@ void ThreadedFileReader::Loop()
 
 ThreadedFileReader::Buffer* ThreadedFileReader::GetBlockPtr(const Chunk& block)
 {
-	for (int i = 0; i < static_cast<int>(std::size(m_buffer)); i++)
+	for (u32 i = 0; i < m_bufferCount; i++)
 	{
 		u32 size = m_buffer[i].size.load(std::memory_order_relaxed);
 		u64 offset = m_buffer[i].offset;
 		if (size && offset <= block.offset && offset + size >= block.offset + block.length)
 		{
-			m_nextBuffer = (i + 1) % std::size(m_buffer);
+			m_nextBuffer = (i + 1) % m_bufferCount;
 			return m_buffer + i;
 		}
 	}
@@ -175,7 +177,7 @@ ThreadedFileReader::Buffer* ThreadedFileReader::GetBlockPtr(const Chunk& block)
 	{
 		buf.offset = block.offset;
 		buf.size.store(size, std::memory_order_release);
-		m_nextBuffer = (m_nextBuffer + 1) % std::size(m_buffer);
+		m_nextBuffer = (m_nextBuffer + 1) % m_bufferCount;
 		return &buf;
 	}
 	return nullptr;
@@ -222,33 +224,70 @@ bool ThreadedFileReader::Decompress(void* target, u64 begin, u32 size)
 
 bool ThreadedFileReader::TryCachedRead(void*& buffer, u64& offset, u32& size, const std::lock_guard<std::mutex>&)
 {
-	// Run through twice so that if m_buffer[1] contains the first half and m_buffer[0] contains the second half it still works
+	// Buffers aren't kept in order, so keep making passes while we're still finding data.
 	m_amtRead = 0;
 	u64 end = 0;
-	bool allDone = false;
-	for (int i = 0; i < static_cast<int>(std::size(m_buffer) * 2); i++)
+	for (u32 pass = 0; pass < m_bufferCount && size > 0; pass++)
 	{
-		Buffer& buf = m_buffer[i % std::size(m_buffer)];
-		u32 bufsize = buf.size.load(std::memory_order_acquire);
-		if (!bufsize)
-			continue;
-		if (buf.offset <= offset && buf.offset + bufsize > offset)
+		bool progress = false;
+		for (u32 i = 0; i < m_bufferCount && size > 0; i++)
 		{
-			u32 off = offset - buf.offset;
-			u32 cpysize = std::min(size, bufsize - off);
-			size_t read = CopyBlocks(buffer, static_cast<char*>(buf.ptr) + off, cpysize);
-			m_amtRead += read;
-			size -= cpysize;
-			offset += cpysize;
-			buffer = static_cast<char*>(buffer) + read;
-			if (size == 0)
-				end = buf.offset + bufsize;
+			Buffer& buf = m_buffer[i];
+			u32 bufsize = buf.size.load(std::memory_order_acquire);
+			if (!bufsize)
+				continue;
+			if (buf.offset <= offset && buf.offset + bufsize > offset)
+			{
+				u32 off = offset - buf.offset;
+				u32 cpysize = std::min(size, bufsize - off);
+				size_t read = CopyBlocks(buffer, static_cast<char*>(buf.ptr) + off, cpysize);
+				m_amtRead += read;
+				size -= cpysize;
+				offset += cpysize;
+				buffer = static_cast<char*>(buffer) + read;
+				if (size == 0)
+					end = buf.offset + bufsize;
+				progress = true;
+			}
+		}
+		if (!progress)
+			break;
+	}
+
+	if (size > 0)
+		return false;
+
+	// Do the buffers contain enough of what comes next? For sequential streams, we want to
+	// top up the readahead once half of it has been consumed, rather than waiting until it's empty.
+	const u32 wanted = IsSequentialStream() ? std::max(m_bufferCount / 2, 1u) : 1u;
+	u32 ahead = 0;
+	for (u32 pass = 0; pass < m_bufferCount && ahead < wanted; pass++)
+	{
+		bool found = false;
+		for (u32 i = 0; i < m_bufferCount; i++)
+		{
+			const u32 bufsize = m_buffer[i].size.load(std::memory_order_acquire);
+			if (bufsize && m_buffer[i].offset == end)
+			{
+				end += bufsize;
+				ahead++;
+				found = true;
+				break;
+			}
 		}
-		// Do buffers contain the current and next block?
-		if (end > 0 && buf.offset == end)
-			allDone = true;
+		if (!found)
+			break;
 	}
-	return allDone;
+	return ahead >= wanted;
+}
+
+void ThreadedFileReader::TrackRequest(u64 offset, u32 size, const std::lock_guard<std::mutex>&)
+{
+	if (offset == m_lastRequestEnd)
+		m_sequentialRequests = std::min(m_sequentialRequests + 1, 0xFFFFu);
+	else
+		m_sequentialRequests = 0;
+	m_lastRequestEnd = offset + size;
 }
 
 bool ThreadedFileReader::Precache(ProgressCallback* progress, Error* error)
@@ -296,8 +335,17 @@ int ThreadedFileReader::ReadSync(void* pBuffer, u32 sector, u32 count)
 	u32 size = count * blocksize;
 	{
 		std::lock_guard<std::mutex> l(m_mtx);
+		TrackRequest(offset, size, l);
 		if (TryCachedRead(pBuffer, offset, size, l))
+		{
+			m_statHits.fetch_add(1, std::memory_order_relaxed);
 			return m_amtRead;
+		}
+
+		if (size > 0)
+			m_statMisses.fetch_add(1, std::memory_order_relaxed);
+		else
+			m_statHits.fetch_add(1, std::memory_order_relaxed);
 
 		if (size > 0 && !m_running)
 		{
@@ -350,17 +398,23 @@ void ThreadedFileReader::BeginRead(void* pBuffer, u32 sector, u32 count)
 	u32 size = count * blocksize;
 	{
 		std::lock_guard<std::mutex> l(m_mtx);
+		TrackRequest(offset, size, l);
 		if (TryCachedRead(pBuffer, offset, size, l))
+		{
+			m_statHits.fetch_add(1, std::memory_order_relaxed);
 			return;
+		}
 		if (size == 0)
 		{
 			// For readahead
+			m_statHits.fetch_add(1, std::memory_order_relaxed);
 			m_requestOffset = offset - 1;
 			m_requestSize = 1;
 			m_requestPtr.store(nullptr, std::memory_order_relaxed);
 		}
 		else
 		{
+			m_statMisses.fetch_add(1, std::memory_order_relaxed);
 			m_requestOffset = offset;
 			m_requestSize = size;
 			m_requestPtr.store(pBuffer, std::memory_order_relaxed);
@@ -374,6 +428,7 @@ int ThreadedFileReader::FinishRead(void)
 {
 	if (m_requestPtr.load(std::memory_order_acquire) == nullptr)
 		return m_amtRead;
+	m_statStalls.fetch_add(1, std::memory_order_relaxed);
 	std::unique_lock<std::mutex> lock(m_mtx);
 	while (m_requestPtr.load(std::memory_order_acquire))
 		m_condition.wait(lock);
@@ -395,6 +450,17 @@ void ThreadedFileReader::Close(void)
 	CancelAndWaitUntilStopped();
 	for (auto& buf : m_buffer)
 		buf.size.store(0, std::memory_order_relaxed);
+	m_sequentialRequests = 0;
+	m_lastRequestEnd = 0;
+
+	const Stats stats = GetStats();
+	if (stats.hits || stats.misses)
+	{
+		DEV_LOG("ThreadedFileReader: {} readahead hits, {} misses, {} stalls ({} buffers)",
+			stats.hits, stats.misses, stats.stalls, m_bufferCount);
+	}
+	ResetStats();
+
 	Close2();
 }
 
@@ -407,3 +473,31 @@ void ThreadedFileReader::SetDataOffset(u32 bytes)
 {
 	m_dataoffset = bytes;
 }
+
+void ThreadedFileReader::SetReadaheadBuffers(u32 count)
+{
+	CancelAndWaitUntilStopped();
+
+	// Anything cached in buffers we're dropping would be stale the next time we grow.
+	std::lock_guard<std::mutex> l(m_mtx);
+	m_bufferCount = std::clamp(count, DEFAULT_READAHEAD_BUFFERS, MAX_READAHEAD_BUFFERS);
+	for (u32 i = m_bufferCount; i < MAX_READAHEAD_BUFFERS; i++)
+		m_buffer[i].size.store(0, std::memory_order_relaxed);
+	m_nextBuffer = 0;
+}
+
+ThreadedFileReader::Stats ThreadedFileReader::GetStats() const
+{
+	return Stats{
+		m_statHits.load(std::memory_order_relaxed),
+		m_statMisses.load(std::memory_order_relaxed),
+		m_statStalls.load(std::memory_order_relaxed),
+	};
+}
+
+void ThreadedFileReader::ResetStats()
+{
+	m_statHits.store(0, std::memory_order_relaxed);
+	m_statMisses.store(0, std::memory_order_relaxed);
+	m_statStalls.store(0, std::memory_order_relaxed);
+}
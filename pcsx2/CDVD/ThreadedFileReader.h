@@ -18,6 +18,22 @@ class ProgressCallback;
 class ThreadedFileReader
 {
 	ThreadedFileReader(ThreadedFileReader&&) = delete;
+public:
+	/// Maximum number of readahead buffers which can be configured
+	static constexpr u32 MAX_READAHEAD_BUFFERS = 16;
+	/// Default number of readahead buffers (current block, next block)
+	static constexpr u32 DEFAULT_READAHEAD_BUFFERS = 2;
+
+	struct Stats
+	{
+		/// Reads which were entirely satisfied from the readahead buffers
+		u64 hits;
+		/// Reads which needed data to be decompressed
+		u64 misses;
+		/// Reads where the caller had to wait for the read thread
+		u64 stalls;
+	};
+
 protected:
 	std::string m_filename;
 
@@ -72,10 +88,21 @@ private:
 		std::atomic<u32> size{0};
 		u32 cap = 0;
 	};
-	/// 2 buffers for readahead (current block, next block)
-	Buffer m_buffer[2];
+	/// Ring of buffers for readahead, only the first `m_bufferCount` are used
+	Buffer m_buffer[MAX_READAHEAD_BUFFERS];
+	u32 m_bufferCount = DEFAULT_READAHEAD_BUFFERS;
 	u32 m_nextBuffer = 0;
 
+	/// End of the last request, used to detect sequential streams
+	u64 m_lastRequestEnd = 0;
+	/// Number of back-to-back requests which continued from the previous one
+	/// View while holding `m_mtx`
+	u32 m_sequentialRequests = 0;
+
+	std::atomic<u64> m_statHits{0};
+	std::atomic<u64> m_statMisses{0};
+	std::atomic<u64> m_statStalls{0};
+
 	std::thread m_readThread;
 	std::mutex m_mtx;
 	std::condition_variable m_condition;
@@ -105,6 +132,13 @@ private:
 	/// Adjusts pointer, offset, and size if successful
 	/// Returns true if no additional reads are necessary
 	bool TryCachedRead(void*& buffer, u64& offset, u32& size, const std::lock_guard<std::mutex>&);
+	/// Updates sequential stream detection for a request starting at `offset` of `size` bytes
+	void TrackRequest(u64 offset, u32 size, const std::lock_guard<std::mutex>&);
+	/// Returns true if the recent requests look like a sequential stream (e.g. FMVs)
+	bool IsSequentialStream() const { return m_sequentialRequests >= 4; }
+	/// Number of buffers to fill ahead of the current request
+	/// View while holding `m_mtx`
+	u32 ReadaheadDepth() const { return IsSequentialStream() ? m_bufferCount : DEFAULT_READAHEAD_BUFFERS; }
 
 public:
 	virtual ~ThreadedFileReader();
@@ -124,4 +158,9 @@ public:
 	void Close();
 	void SetBlockSize(u32 bytes);
 	void SetDataOffset(u32 bytes);
+	/// Sets the number of buffers used for readahead when streaming sequentially
+	void SetReadaheadBuffers(u32 count);
+
+	Stats GetStats() const;
+	void ResetStats();
 };
@@ -49,6 +49,8 @@ Comments) 1950 to 1952 in the files http://tools.ietf.org/html/rfc1950
       (Thanks to Mark Adler for suggesting the approach)
   - build_index(...) - added progress prints
   - CHUNK changed from 16k to 512k
+  - extract: binary search for the access point, so a memory mapped index only
+      touches the pages of the points it visits
  */
 
 /* Illustrate the use of Z_BLOCK, inflatePrime(), and inflateSetDictionary()
@@ -386,11 +388,17 @@ static inline int extract(FILE* in, struct access* index, s64 offset,
 	}
 	else
 	{
-		/* find where in stream to start */
-		here = index->list;
-		ret = index->have;
-		while (--ret && here[1].out <= offset)
-			here++;
+		/* find where in stream to start (last point with out <= offset) */
+		int lo = 0, hi = index->have - 1;
+		while (lo < hi)
+		{
+			const int mid = lo + (hi - lo + 1) / 2;
+			if (index->list[mid].out <= offset)
+				lo = mid;
+			else
+				hi = mid - 1;
+		}
+		here = index->list + lo;
 
 		/* initialize file and inflate state to start there */
 		state->strm.zalloc = Z_NULL;
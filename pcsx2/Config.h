@@ -1336,6 +1336,10 @@ struct Pcsx2Config
 		SavestateCompressionMethod CompressionType = SavestateCompressionMethod::Zstandard;
 		SavestateCompressionLevel CompressionRatio = SavestateCompressionLevel::Medium;
 
+		bool RewindEnable = false;
+		u32 RewindFrequency = 10; // frames between rewind captures
+		u32 RewindBufferSize = 256; // in megabytes
+
 		bool operator==(const SavestateOptions& right) const;
 		bool operator!=(const SavestateOptions& right) const;
 	};
@@ -1394,6 +1398,7 @@ struct Pcsx2Config
 	// slots (3 each)
 	McdOptions Mcd[8];
 	std::string GzipIsoIndexTemplate; // for quick-access index with gzipped ISO
+	int CdvdReadaheadBuffers; // number of readahead buffers for compressed images when streaming
 
 	int PINESlot;
 
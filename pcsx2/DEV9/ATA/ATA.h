@@ -8,6 +8,8 @@
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
+#include <list>
+#include <unordered_map>
 
 #include "common/RedtapeWindows.h"
 #include "common/Path.h"
@@ -27,6 +29,23 @@ private:
 	std::FILE* hddImage = nullptr;
 	u64 hddImageSize;
 
+	//Sequential writes are combined in the stdio buffer, flushing is deferred until the write queue drains
+	static constexpr size_t hddStreamBufferSize = 1024 * 1024;
+	//Set by reads that leave the file position where the read ended, the next write must seek first
+	bool hddLastOpWasRead = false;
+
+	//Read cache, LRU of fixed size blocks, kept in sync by writes
+	//Only accessed by the IO thread, or while it is idle
+	static constexpr u32 hddCacheBlockSize = 64 * 1024;
+	static constexpr u32 hddCacheMaxBlocks = 256; //16MiB
+	struct CacheBlock
+	{
+		std::unique_ptr<u8[]> data;
+		std::list<u64>::iterator lruPos;
+	};
+	std::unordered_map<u64, CacheBlock> hddCache;
+	std::list<u64> hddCacheLRU; //Most recently used at front
+
 	bool hddSparse = false;
 	u64 hddSparseBlockSize;
 	u64 HddSparseStart;
@@ -219,6 +238,9 @@ private:
 	void IO_SparseCacheAssertFileZeros(u64 hddSparseBlockSizeReadable);
 #endif
 	bool IsAllZero(const void* data, size_t len);
+	const u8* IO_CacheGetBlock(u64 blockIndex);
+	void IO_CacheUpdate(u64 byteOffset, const u8* data, u32 length);
+	void IO_CacheClear();
 	void HDD_ReadAsync(void (ATA::*drqCMD)());
 	void HDD_ReadSync(void (ATA::*drqCMD)());
 	bool HDD_CanAssessOrSetError();
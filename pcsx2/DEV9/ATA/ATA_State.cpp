@@ -53,6 +53,7 @@ int ATA::Open(const std::string& hddPath)
 		Console.Error("DEV9: ATA: Failed to open HDD image '%s'", hddPath.c_str());
 		return -1;
 	}
+	std::setvbuf(hddImage, nullptr, _IOFBF, hddStreamBufferSize);
 
 	// Open and read the content of the hddid file
 	std::string hddidPath = Path::ReplaceExtension(hddPath, "hddid");
@@ -286,6 +287,7 @@ void ATA::Close()
 		std::fclose(hddImage);
 		hddImage = nullptr;
 	}
+	IO_CacheClear();
 
 	delete[] readBuffer;
 	readBuffer = nullptr;
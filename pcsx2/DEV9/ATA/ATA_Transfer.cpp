@@ -68,12 +68,16 @@ void ATA::IO_Read()
 	}
 
 	const u64 pos = lba * 512;
-	if (FileSystem::FSeek64(hddImage, pos, SEEK_SET) != 0 ||
-		std::fread(readBuffer,  512, nsector, hddImage) != static_cast<size_t>(nsector))
+	const u64 length = static_cast<u64>(nsector) * 512;
+	u64 read = 0;
+	while (read != length)
 	{
-		Console.Error("DEV9: ATA: File read error");
-		pxAssert(false);
-		abort();
+		const u64 blockOffset = (pos + read) % hddCacheBlockSize;
+		const u64 readSize = std::min<u64>(hddCacheBlockSize - blockOffset, length - read);
+
+		const u8* block = IO_CacheGetBlock((pos + read) / hddCacheBlockSize);
+		memcpy(&readBuffer[read], &block[blockOffset], readSize);
+		read += readSize;
 	}
 	{
 		std::lock_guard ioSignallock(ioMutex);
@@ -86,18 +90,31 @@ bool ATA::IO_Write()
 	WriteQueueEntry entry;
 	if (!writeQueue.Dequeue(&entry))
 	{
+		// Queue drained, write out anything left in the stdio buffer.
+		if (std::fflush(hddImage) != 0)
+		{
+			Console.Error("DEV9: ATA: File write error");
+			pxAssert(false);
+			abort();
+		}
 		std::lock_guard ioSignallock(ioMutex);
 		ioWrite = false;
 		return false;
 	}
 
 	const u64 imagePos = entry.sector * 512;
-	if (FileSystem::FSeek64(hddImage, imagePos, SEEK_SET) != 0)
+	IO_CacheUpdate(imagePos, entry.data, entry.length);
+
+	// Seeking flushes the stdio buffer, skip it for sequential writes so they can be combined.
+	// A write directly after a read must always seek, stdio doesn't allow switching without one.
+	if ((hddLastOpWasRead || FileSystem::FTell64(hddImage) != static_cast<s64>(imagePos)) &&
+		FileSystem::FSeek64(hddImage, imagePos, SEEK_SET) != 0)
 	{
 		Console.Error("DEV9: ATA: File seek error");
 		pxAssert(false);
 		abort();
 	}
+	hddLastOpWasRead = false;
 	if (hddSparse)
 	{
 		u32 written = 0;
@@ -156,8 +173,7 @@ bool ATA::IO_Write()
 				if (hddSparseBlockValid)
 					memcpy(&hddSparseBlock[(imagePos + written) - HddSparseStart], &entry.data[written], writeSize);
 
-				if (std::fwrite(&entry.data[written], writeSize, 1, hddImage) != 1 ||
-					std::fflush(hddImage) != 0)
+				if (std::fwrite(&entry.data[written], writeSize, 1, hddImage) != 1)
 				{
 					Console.Error("DEV9: ATA: File write error");
 					pxAssert(false);
@@ -170,7 +186,7 @@ bool ATA::IO_Write()
 	}
 	else
 	{
-		if (std::fwrite(entry.data, entry.length, 1, hddImage) != 1 || std::fflush(hddImage) != 0)
+		if (std::fwrite(entry.data, entry.length, 1, hddImage) != 1)
 		{
 			Console.Error("DEV9: ATA: File write error");
 			pxAssert(false);
@@ -332,8 +348,7 @@ bool ATA::IO_SparseZero(u64 byteOffset, u64 byteSize)
 #endif
 
 		//No, do normal write
-		if (std::fwrite((char*)&hddSparseBlock[byteOffset - HddSparseStart], byteSize, 1, hddImage) != 1 ||
-			std::fflush(hddImage) != 0)
+		if (std::fwrite((char*)&hddSparseBlock[byteOffset - HddSparseStart], byteSize, 1, hddImage) != 1)
 		{
 			Console.Error("DEV9: ATA: File write error");
 			pxAssert(false);
@@ -349,6 +364,13 @@ bool ATA::IO_SparseZero(u64 byteOffset, u64 byteSize)
 #endif
 
 	//Yes, try sparse write
+	//Buffered writes to this block must land before the hole is punched
+	if (std::fflush(hddImage) != 0)
+	{
+		Console.Error("DEV9: ATA: File write error");
+		pxAssert(false);
+		abort();
+	}
 #ifdef _WIN32
 	FILE_ZERO_DATA_INFORMATION sparseRange;
 	sparseRange.FileOffset.QuadPart = HddSparseStart;
@@ -388,6 +410,72 @@ bool ATA::IO_SparseZero(u64 byteOffset, u64 byteSize)
 	return true;
 }
 
+const u8* ATA::IO_CacheGetBlock(u64 blockIndex)
+{
+	const auto it = hddCache.find(blockIndex);
+	if (it != hddCache.end())
+	{
+		hddCacheLRU.splice(hddCacheLRU.begin(), hddCacheLRU, it->second.lruPos);
+		return it->second.data.get();
+	}
+
+	// Reuse the least recently used block, if full.
+	std::unique_ptr<u8[]> data;
+	if (hddCache.size() >= hddCacheMaxBlocks)
+	{
+		const auto oldIt = hddCache.find(hddCacheLRU.back());
+		data = std::move(oldIt->second.data);
+		hddCache.erase(oldIt);
+		hddCacheLRU.pop_back();
+	}
+	else
+		data = std::make_unique<u8[]>(hddCacheBlockSize);
+
+	// Reads are bounds checked, but the block may extend past the end of the image.
+	const u64 blockPos = blockIndex * hddCacheBlockSize;
+	const u64 readSize = std::min<u64>(hddCacheBlockSize, hddImageSize - blockPos);
+	if (readSize != hddCacheBlockSize)
+		memset(&data[readSize], 0, hddCacheBlockSize - readSize);
+
+	if (FileSystem::FSeek64(hddImage, blockPos, SEEK_SET) != 0 ||
+		std::fread(data.get(), readSize, 1, hddImage) != 1)
+	{
+		Console.Error("DEV9: ATA: File read error");
+		pxAssert(false);
+		abort();
+	}
+	hddLastOpWasRead = true;
+
+	hddCacheLRU.push_front(blockIndex);
+	CacheBlock& block = hddCache[blockIndex];
+	block.data = std::move(data);
+	block.lruPos = hddCacheLRU.begin();
+	return block.data.get();
+}
+
+// Write through, blocks not already cached are left for the next read.
+void ATA::IO_CacheUpdate(u64 byteOffset, const u8* data, u32 length)
+{
+	u32 written = 0;
+	while (written != length)
+	{
+		const u64 blockOffset = (byteOffset + written) % hddCacheBlockSize;
+		const u32 writeSize = static_cast<u32>(std::min<u64>(hddCacheBlockSize - blockOffset, length - written));
+
+		const auto it = hddCache.find((byteOffset + written) / hddCacheBlockSize);
+		if (it != hddCache.end())
+			memcpy(&it->second.data[blockOffset], &data[written], writeSize);
+
+		written += writeSize;
+	}
+}
+
+void ATA::IO_CacheClear()
+{
+	hddCache.clear();
+	hddCacheLRU.clear();
+}
+
 bool ATA::IsAllZero(const void* data, size_t len)
 {
 	intmax_t* pbi = (intmax_t*)data;
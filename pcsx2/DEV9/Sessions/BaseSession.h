@@ -53,6 +53,18 @@ namespace Sessions
 		virtual bool Send(PacketReader::IP::IP_Payload* payload) = 0;
 		virtual void Reset() = 0;
 
+		/*
+		 * Readiness hints for the adapter's recv loop.
+		 * GetPollFd() returns a host socket that becomes readable when Recv() has data,
+		 * HasPendingWork() reports if Recv() needs calling regardless of socket readiness.
+		 * Idle timeouts are handled by a periodic sweep, so don't need reporting here.
+		 * Sessions that can't tell keep the defaults, and get polled on every recv.
+		 */
+#ifdef __linux__
+		virtual int GetPollFd() { return -1; }
+#endif
+		virtual bool HasPendingWork() { return true; }
+
 		virtual ~BaseSession() {}
 
 	protected:
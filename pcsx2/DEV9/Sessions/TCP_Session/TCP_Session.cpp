@@ -152,6 +152,21 @@ namespace Sessions
 		RaiseEventConnectionClosed();
 	}
 
+#ifdef __linux__
+	int TCP_Session::GetPollFd()
+	{
+		return client;
+	}
+#endif
+
+	bool TCP_Session::HasPendingWork()
+	{
+		// Connecting is signalled by writability, and closing isn't signalled by the socket at all
+		return !_recvBuff.IsQueueEmpty() ||
+			   state == TCP_State::SendingSYN_ACK ||
+			   state == TCP_State::CloseCompletedFlushBuffer;
+	}
+
 	TCP_Session::~TCP_Session()
 	{
 		CloseSocket();
@@ -148,6 +148,18 @@ namespace Sessions
 			connectionsCopy[i]->Reset();
 	}
 
+#ifdef __linux__
+	int UDP_FixedPort::GetPollFd()
+	{
+		return client;
+	}
+#endif
+
+	bool UDP_FixedPort::HasPendingWork()
+	{
+		return false;
+	}
+
 	UDP_Session* UDP_FixedPort::NewClientSession(ConnectionKey parNewKey, bool parIsBrodcast, bool parIsMulticast)
 	{
 		// Lock the whole function so we can't race between the open check and creating the session
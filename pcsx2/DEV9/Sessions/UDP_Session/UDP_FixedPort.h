@@ -44,6 +44,11 @@ namespace Sessions
 		virtual bool Send(PacketReader::IP::IP_Payload* payload);
 		virtual void Reset();
 
+#ifdef __linux__
+		virtual int GetPollFd();
+#endif
+		virtual bool HasPendingWork();
+
 		UDP_Session* NewClientSession(ConnectionKey parNewKey, bool parIsBrodcast, bool parIsMulticast);
 
 		virtual ~UDP_FixedPort();
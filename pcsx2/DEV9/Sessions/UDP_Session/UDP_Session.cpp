@@ -251,6 +251,19 @@ namespace Sessions
 		RaiseEventConnectionClosed();
 	}
 
+#ifdef __linux__
+	int UDP_Session::GetPollFd()
+	{
+		// Fixed port sessions share the socket of their UDP_FixedPort, which is polled instead
+		return isFixedPort ? -1 : client;
+	}
+#endif
+
+	bool UDP_Session::HasPendingWork()
+	{
+		return false;
+	}
+
 	UDP_Session::~UDP_Session()
 	{
 		open.store(false);
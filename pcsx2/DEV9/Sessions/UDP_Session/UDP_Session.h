@@ -51,6 +51,11 @@ namespace Sessions
 		virtual bool Send(PacketReader::IP::IP_Payload* payload);
 		virtual void Reset();
 
+#ifdef __linux__
+		virtual int GetPollFd();
+#endif
+		virtual bool HasPendingWork();
+
 		virtual ~UDP_Session();
 	};
 } // namespace Sessions
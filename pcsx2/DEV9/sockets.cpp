@@ -17,6 +17,10 @@
 #include <netinet/in.h>
 #include <net/if.h>
 #endif
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <unistd.h>
+#endif
 
 #include "sockets.h"
 #include "AdapterUtils.h"
@@ -42,6 +46,12 @@ using namespace PacketReader::IP::ICMP;
 using namespace PacketReader::IP::TCP;
 using namespace PacketReader::IP::UDP;
 
+#ifdef __linux__
+static constexpr int MAX_POLL_EVENTS = 64;
+// Only needs to be often enough to catch idle timeouts
+static constexpr std::chrono::milliseconds POLL_SWEEP_INTERVAL{100};
+#endif
+
 std::vector<AdapterEntry> SocketAdapter::GetAdapters()
 {
 	std::vector<AdapterEntry> nic;
@@ -183,6 +193,13 @@ SocketAdapter::SocketAdapter()
 		wsa_init = true;
 #endif
 
+#ifdef __linux__
+	epollFd = epoll_create1(EPOLL_CLOEXEC);
+	if (epollFd == -1)
+		Console.Error("DEV9: Socket: epoll_create1 failed, polling all connections. Error code: %d", errno);
+	pollLastSweep = std::chrono::steady_clock::now();
+#endif
+
 	sendThreadId = std::this_thread::get_id();
 
 	initialized = true;
@@ -218,6 +235,10 @@ bool SocketAdapter::recv(NetPacket* pkt)
 	if (!vRecBuffer.Dequeue(&bFrame))
 	{
 		std::lock_guard deletelock(deleteSendSentry);
+#ifdef __linux__
+		if (epollFd != -1)
+			return RecvReady(pkt);
+#endif
 		std::vector<ConnectionKey> keys = connections.GetKeys();
 		for (size_t i = 0; i < keys.size(); i++)
 		{
@@ -227,23 +248,8 @@ bool SocketAdapter::recv(NetPacket* pkt)
 			if (!connections.TryGetValue(key, &session))
 				continue;
 
-			std::optional<ReceivedPayload> pl = session->Recv();
-
-			if (pl.has_value())
-			{
-				IP_Packet* ipPkt = new IP_Packet(pl->payload.release());
-				ipPkt->destinationIP = session->sourceIP;
-				ipPkt->sourceIP = pl->sourceIP;
-
-				EthernetFrame frame(ipPkt);
-				frame.sourceMAC = internalMAC;
-				frame.destinationMAC = ps2MAC;
-				frame.protocol = static_cast<u16>(EtherType::IPv4);
-
-				frame.WritePacket(pkt);
-				InspectRecv(pkt);
+			if (RecvFromSession(session, pkt))
 				return true;
-			}
 		}
 	}
 	else
@@ -257,6 +263,199 @@ bool SocketAdapter::recv(NetPacket* pkt)
 	return false;
 }
 
+bool SocketAdapter::RecvFromSession(BaseSession* session, NetPacket* pkt)
+{
+	std::optional<ReceivedPayload> pl = session->Recv();
+	if (!pl.has_value())
+		return false;
+
+	IP_Packet* ipPkt = new IP_Packet(pl->payload.release());
+	ipPkt->destinationIP = session->sourceIP;
+	ipPkt->sourceIP = pl->sourceIP;
+
+	EthernetFrame frame(ipPkt);
+	frame.sourceMAC = internalMAC;
+	frame.destinationMAC = ps2MAC;
+	frame.protocol = static_cast<u16>(EtherType::IPv4);
+
+	frame.WritePacket(pkt);
+	InspectRecv(pkt);
+	return true;
+}
+
+#ifdef __linux__
+bool SocketAdapter::RecvReady(NetPacket* pkt)
+{
+	epoll_event events[MAX_POLL_EVENTS];
+	const int count = epoll_wait(epollFd, events, MAX_POLL_EVENTS, 0);
+	if (count == -1 && errno != EINTR)
+		Console.Error("DEV9: Socket: epoll_wait failed. Error code: %d", errno);
+
+	std::vector<ConnectionKey> candidates;
+	{
+		std::lock_guard pollLock(pollSentry);
+		// Take the pending set before calling Recv(), so a session marked
+		// by the send thread while we are servicing it isn't lost
+		candidates.reserve(pollPending.size() + std::max(count, 0));
+		candidates.insert(candidates.end(), pollPending.begin(), pollPending.end());
+		pollPending.clear();
+
+		for (int i = 0; i < count; i++)
+		{
+			const auto it = pollFdKeys.find(events[i].data.fd);
+			if (it != pollFdKeys.end())
+				candidates.push_back(it->second);
+		}
+	}
+
+	bool received = false;
+	std::vector<ConnectionKey> requeue;
+	for (const ConnectionKey& key : candidates)
+	{
+		BaseSession* session;
+		if (!connections.TryGetValue(key, &session))
+			continue;
+
+		// Ready sockets will be reported again, but pending work would be lost
+		if (received)
+		{
+			requeue.push_back(key);
+			continue;
+		}
+
+		// A session that returned a packet may have more queued
+		received = RecvFromSession(session, pkt);
+		if (received || session->HasPendingWork())
+			requeue.push_back(key);
+	}
+
+	if (requeue.size() != 0)
+	{
+		std::lock_guard pollLock(pollSentry);
+		pollPending.insert(requeue.begin(), requeue.end());
+	}
+
+	if (received)
+		return true;
+
+	// Service every session at a low rate, for idle timeouts
+	// Resumes where it left off if a previous sweep returned a packet
+	if (pollSweepKeys.size() == 0)
+	{
+		const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		if (now - pollLastSweep < POLL_SWEEP_INTERVAL)
+			return false;
+
+		pollSweepKeys = connections.GetKeys();
+		pollLastSweep = now;
+	}
+
+	while (pollSweepKeys.size() != 0)
+	{
+		const ConnectionKey key = pollSweepKeys.back();
+		pollSweepKeys.pop_back();
+
+		BaseSession* session;
+		if (!connections.TryGetValue(key, &session))
+			continue;
+
+		received = RecvFromSession(session, pkt);
+		if (received || session->HasPendingWork())
+		{
+			std::lock_guard pollLock(pollSentry);
+			pollPending.insert(key);
+		}
+
+		if (received)
+			return true;
+	}
+	return false;
+}
+#endif
+
+void SocketAdapter::MarkSessionActive(BaseSession* session)
+{
+#ifdef __linux__
+	if (epollFd == -1)
+		return;
+
+	const ConnectionKey key = session->key;
+	std::lock_guard pollLock(pollSentry);
+
+	// The session may have closed while sending
+	// Checked under pollSentry so we can't race with UnregisterSession()
+	BaseSession* current;
+	if (!connections.TryGetValue(key, &current) || current != session)
+		return;
+
+	pollPending.insert(key);
+
+	const int fd = session->GetPollFd();
+	const auto it = pollKeyFds.find(key);
+	if (it != pollKeyFds.end())
+	{
+		if (it->second == fd)
+			return;
+
+		// Socket was replaced, only remove the old fd if it wasn't reused by another session
+		const auto oldIt = pollFdKeys.find(it->second);
+		if (oldIt != pollFdKeys.end() && oldIt->second == key)
+		{
+			epoll_ctl(epollFd, EPOLL_CTL_DEL, it->second, nullptr);
+			pollFdKeys.erase(oldIt);
+		}
+		pollKeyFds.erase(it);
+	}
+
+	if (fd == -1)
+		return;
+
+	epoll_event ev{};
+	ev.events = EPOLLIN;
+	ev.data.fd = fd;
+	// A closed socket is dropped from the epoll set by the kernel, which the maps can't see
+	// If the fd was reused, it may still be present in our maps, but not the epoll set
+	if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) == -1 &&
+		(errno != EEXIST || epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &ev) == -1))
+	{
+		// The periodic sweep will still service the session, just with added latency
+		Console.Error("DEV9: Socket: Failed to register connection for polling. Error code: %d", errno);
+		return;
+	}
+
+	const auto staleIt = pollFdKeys.find(fd);
+	if (staleIt != pollFdKeys.end())
+		pollKeyFds.erase(staleIt->second);
+
+	pollKeyFds[key] = fd;
+	pollFdKeys[fd] = key;
+#endif
+}
+
+void SocketAdapter::UnregisterSession(const ConnectionKey& key)
+{
+#ifdef __linux__
+	if (epollFd == -1)
+		return;
+
+	std::lock_guard pollLock(pollSentry);
+	pollPending.erase(key);
+
+	const auto it = pollKeyFds.find(key);
+	if (it == pollKeyFds.end())
+		return;
+
+	// Sockets are still open at this point, deletion is deferred
+	const auto fdIt = pollFdKeys.find(it->second);
+	if (fdIt != pollFdKeys.end() && fdIt->second == key)
+	{
+		epoll_ctl(epollFd, EPOLL_CTL_DEL, it->second, nullptr);
+		pollFdKeys.erase(fdIt);
+	}
+	pollKeyFds.erase(it);
+#endif
+}
+
 bool SocketAdapter::send(NetPacket* pkt)
 {
 	InspectSend(pkt);
@@ -416,7 +615,9 @@ bool SocketAdapter::SendICMP(ConnectionKey Key, IP_Packet* ipPkt)
 	if (existingSession != nullptr)
 	{
 		s = static_cast<ICMP_Session*>(existingSession);
-		return s->Send(ipPkt->GetPayload(), ipPkt);
+		const bool ret = s->Send(ipPkt->GetPayload(), ipPkt);
+		MarkSessionActive(s);
+		return ret;
 	}
 
 	DevCon.WriteLn("DEV9: Socket: Creating New ICMP Connection");
@@ -426,7 +627,9 @@ bool SocketAdapter::SendICMP(ConnectionKey Key, IP_Packet* ipPkt)
 	s->destIP = ipPkt->destinationIP;
 	s->sourceIP = dhcpServer.ps2IP;
 	connections.Add(Key, s);
-	return s->Send(ipPkt->GetPayload(), ipPkt);
+	const bool ret = s->Send(ipPkt->GetPayload(), ipPkt);
+	MarkSessionActive(s);
+	return ret;
 }
 
 bool SocketAdapter::SendIGMP(ConnectionKey Key, IP_Packet* ipPkt)
@@ -457,7 +660,9 @@ bool SocketAdapter::SendTCP(ConnectionKey Key, IP_Packet* ipPkt)
 		s->destIP = ipPkt->destinationIP;
 		s->sourceIP = dhcpServer.ps2IP;
 		connections.Add(Key, s);
-		return s->Send(ipPkt->GetPayload());
+		const bool ret = s->Send(ipPkt->GetPayload());
+		MarkSessionActive(s);
+		return ret;
 	}
 }
 
@@ -503,6 +708,7 @@ bool SocketAdapter::SendUDP(ConnectionKey Key, IP_Packet* ipPkt)
 			fixedUDPPorts.Add(udp.sourcePort, fPort);
 
 			fPort->Init();
+			MarkSessionActive(fPort);
 		}
 
 		Console.WriteLn("DEV9: Socket: Creating New UDP Connection from fixed port %d to %d", udp.sourcePort, udp.destinationPort);
@@ -522,7 +728,9 @@ bool SocketAdapter::SendUDP(ConnectionKey Key, IP_Packet* ipPkt)
 		s->destIP = ipPkt->destinationIP;
 		s->sourceIP = dhcpServer.ps2IP;
 		connections.Add(Key, s);
-		return s->Send(ipPkt->GetPayload());
+		const bool ret = s->Send(ipPkt->GetPayload());
+		MarkSessionActive(s);
+		return ret;
 	}
 }
 
@@ -531,7 +739,11 @@ int SocketAdapter::SendFromConnection(ConnectionKey Key, IP_Packet* ipPkt)
 	BaseSession* s = nullptr;
 	connections.TryGetValue(Key, &s);
 	if (s != nullptr)
-		return s->Send(ipPkt->GetPayload()) ? 1 : 0;
+	{
+		const bool ret = s->Send(ipPkt->GetPayload());
+		MarkSessionActive(s);
+		return ret ? 1 : 0;
+	}
 	else
 		return -1;
 }
@@ -541,6 +753,7 @@ void SocketAdapter::HandleConnectionClosed(BaseSession* sender)
 	const ConnectionKey key = sender->key;
 	if (!connections.Remove(key))
 		return;
+	UnregisterSession(key);
 
 	// Defer deleting the connection untill we have left the calling session's callstack
 	if (std::this_thread::get_id() == sendThreadId)
@@ -573,6 +786,7 @@ void SocketAdapter::HandleFixedPortClosed(BaseSession* sender)
 	const ConnectionKey key = sender->key;
 	if (!connections.Remove(key))
 		return;
+	UnregisterSession(key);
 	fixedUDPPorts.Remove(key.ps2Port);
 
 	// Defer deleting the connection untill we have left the calling session's callstack
@@ -604,6 +818,11 @@ SocketAdapter::~SocketAdapter()
 	connections.Clear();
 	fixedUDPPorts.Clear(); //fixedUDP sessions already deleted via connections
 
+#ifdef __linux__
+	if (epollFd != -1)
+		::close(epollFd);
+#endif
+
 	//Clear out any delete queues
 	DevCon.WriteLn("DEV9: Socket: Found %d Connections in send delete queue", deleteQueueSendThread.size());
 	DevCon.WriteLn("DEV9: Socket: Found %d Connections in recv delete queue", deleteQueueRecvThread.size());
@@ -2,7 +2,10 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #pragma once
+#include <chrono>
 #include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "net.h"
@@ -36,6 +39,19 @@ class SocketAdapter : public NetAdapter
 	std::mutex deleteSendSentry;
 	std::mutex deleteRecvSentry;
 
+#ifdef __linux__
+	// Readiness driven recv, sessions are only serviced when their socket is readable,
+	// after the send thread has passed them a packet, or on a periodic sweep for idle timeouts.
+	int epollFd = -1;
+	std::mutex pollSentry;
+	std::unordered_map<Sessions::ConnectionKey, int> pollKeyFds;
+	std::unordered_map<int, Sessions::ConnectionKey> pollFdKeys;
+	std::unordered_set<Sessions::ConnectionKey> pollPending;
+	// Accessed by recv thread only
+	std::vector<Sessions::ConnectionKey> pollSweepKeys;
+	std::chrono::steady_clock::time_point pollLastSweep;
+#endif
+
 public:
 	SocketAdapter();
 	virtual bool blocks();
@@ -60,6 +76,14 @@ private:
 
 	int SendFromConnection(Sessions::ConnectionKey Key, PacketReader::IP::IP_Packet* ipPkt);
 
+	bool RecvFromSession(Sessions::BaseSession* session, NetPacket* pkt);
+#ifdef __linux__
+	bool RecvReady(NetPacket* pkt);
+#endif
+	//Registers the session's socket for polling, and marks it as needing a recv
+	void MarkSessionActive(Sessions::BaseSession* session);
+	void UnregisterSession(const Sessions::ConnectionKey& key);
+
 	//Event must only be raised once per connection
 	void HandleConnectionClosed(Sessions::BaseSession* sender);
 	void HandleFixedPortClosed(Sessions::BaseSession* sender);
@@ -19,6 +19,7 @@
 #include "common/SmallString.h"
 #include "common/StringUtil.h"
 #include "common/Threading.h"
+#include "common/Timer.h"
 
 #include <atomic>
 #include <condition_variable>
@@ -135,8 +136,14 @@ extern "C" {
 
 namespace GSCapture
 {
+	// Readbacks are mapped this many frames after they're queued, so the GPU copy has long finished by then.
 	static constexpr u32 NUM_FRAMES_IN_FLIGHT = 3;
-	static constexpr u32 MAX_PENDING_FRAMES = NUM_FRAMES_IN_FLIGHT * 2;
+
+	// Mapped frames the encoder can fall behind by before the GS thread has to wait for it. The encoder reads
+	// straight from the mapped download texture, so each one holds a texture rather than a copy of the frame.
+	static constexpr u32 NUM_FRAMES_ENCODE_QUEUE = 5;
+
+	static constexpr u32 MAX_PENDING_FRAMES = NUM_FRAMES_IN_FLIGHT + NUM_FRAMES_ENCODE_QUEUE;
 	static constexpr u32 AUDIO_BUFFER_SIZE = Common::AlignUpPow2((MAX_PENDING_FRAMES * 48000) / 60, AudioStream::CHUNK_SIZE);
 	static constexpr u32 AUDIO_CHANNELS = 2;
 
@@ -211,6 +218,11 @@ namespace GSCapture
 	static u32 s_frames_pending_encode = 0;
 	static u32 s_frames_encode_consume_pos = 0;
 
+	// Frames the GS thread had to wait for the encoder on, and frames missing from the output.
+	static std::atomic<u32> s_frames_late{0};
+	static std::atomic<u32> s_frames_dropped{0};
+	static Common::Timer::Value s_late_wait_time = 0;
+
 	// NOTE: So this doesn't need locking, we allocate it once, and leave it.
 	static std::unique_ptr<float[]> s_audio_buffer;
 	static std::atomic<u32> s_audio_buffer_size{0};
@@ -872,7 +884,10 @@ bool GSCapture::DeliverVideoFrame(GSTexture* stex)
 	pxAssert(pf.state != PendingFrame::State::NeedsMap);
 	if (pf.state == PendingFrame::State::NeedsEncoding)
 	{
+		const Common::Timer::Value wait_start = Common::Timer::GetCurrentValue();
 		s_frame_encoded_cv.wait(lock, [&pf]() { return pf.state == PendingFrame::State::Unused; });
+		s_late_wait_time += Common::Timer::GetCurrentValue() - wait_start;
+		s_frames_late.fetch_add(1, std::memory_order_relaxed);
 	}
 
 	if (!pf.tex || pf.tex->GetWidth() != static_cast<u32>(stex->GetWidth()) || pf.tex->GetHeight() != static_cast<u32>(stex->GetHeight()))
@@ -882,6 +897,7 @@ bool GSCapture::DeliverVideoFrame(GSTexture* stex)
 		if (!pf.tex)
 		{
 			Console.Error("GSCapture: Failed to create %x%d download texture", stex->GetWidth(), stex->GetHeight());
+			s_frames_dropped.fetch_add(1, std::memory_order_relaxed);
 			return false;
 		}
 
@@ -949,8 +965,13 @@ void GSCapture::EncoderThreadEntryPoint()
 		bool okay = !s_encoding_error;
 
 		// If the frame failed to map, this will be false, and we'll just skip it.
-		if (okay && s_video_stream && pf.tex->IsMapped())
-			okay = SendFrame(pf);
+		if (okay && s_video_stream)
+		{
+			if (pf.tex->IsMapped())
+				okay = SendFrame(pf);
+			else
+				s_frames_dropped.fetch_add(1, std::memory_order_relaxed);
+		}
 
 		// Encode as many audio frames while the video is ahead.
 		if (okay && s_audio_stream)
@@ -1268,6 +1289,16 @@ void GSCapture::InternalEndCapture(std::unique_lock<std::mutex>& lock)
 		s_capturing.store(false, std::memory_order_release);
 		StopEncoderThread(lock);
 
+		if (s_video_stream)
+		{
+			Console.WriteLn("GSCapture: %lld frames captured, %u late (%.2f ms waiting on the encoder), %u dropped.",
+				static_cast<long long>(s_next_video_pts), s_frames_late.load(std::memory_order_relaxed),
+				Common::Timer::ConvertValueToMilliseconds(s_late_wait_time), s_frames_dropped.load(std::memory_order_relaxed));
+		}
+		s_frames_late.store(0, std::memory_order_relaxed);
+		s_frames_dropped.store(0, std::memory_order_relaxed);
+		s_late_wait_time = 0;
+
 		s_pending_frames = {};
 		s_pending_frames_pos = 0;
 		s_frames_pending_map = 0;
@@ -1382,6 +1413,16 @@ bool GSCapture::IsCapturingAudio()
 	return (s_audio_stream != nullptr);
 }
 
+u32 GSCapture::GetLateFrameCount()
+{
+	return s_frames_late.load(std::memory_order_relaxed);
+}
+
+u32 GSCapture::GetDroppedFrameCount()
+{
+	return s_frames_dropped.load(std::memory_order_relaxed);
+}
+
 TinyString GSCapture::GetElapsedTime()
 {
 	std::unique_lock<std::mutex> lock(s_lock);
@@ -28,6 +28,10 @@ namespace GSCapture
 	bool IsCapturingVideo();
 	bool IsCapturingAudio();
 	TinyString GetElapsedTime();
+
+	/// Frames which had to wait for the encoder to catch up, and frames which didn't make it into the output.
+	u32 GetLateFrameCount();
+	u32 GetDroppedFrameCount();
 	const Threading::ThreadHandle& GetEncoderThreadHandle();
 	GSVector2i GetSize();
 	std::string GetNextCaptureFileName();
@@ -7,6 +7,7 @@
 #include "GS/GSState.h"
 
 #include "common/Console.h"
+#include "common/Error.h"
 #include "common/FileSystem.h"
 #include "common/HeapArray.h"
 #include "common/ScopedGuard.h"
@@ -28,8 +29,18 @@ GSDumpBase::GSDumpBase(std::string fn)
 
 GSDumpBase::~GSDumpBase()
 {
-	if (m_gs)
-		std::fclose(m_gs);
+	if (!m_gs)
+		return;
+
+	std::fclose(m_gs);
+
+	if (!m_frame_index.empty() && m_frame_index.back().offset != m_stream_offset)
+		m_frame_index.push_back({m_stream_offset, m_packets});
+
+	// Saves the replayer from decompressing the whole dump just to find the frames.
+	Error error;
+	if (m_frame_index.size() >= 2 && !GSDumpFile::WriteFrameIndex(m_filename.c_str(), m_frame_index, m_seek_points, &error))
+		Console.WarningFmt("GSDump: Failed to write frame index: {}", error.GetDescription());
 }
 
 void GSDumpBase::AddHeader(const std::string& serial, u32 crc,
@@ -66,6 +77,9 @@ void GSDumpBase::AddHeader(const std::string& serial, u32 crc,
 	// Then the real state data.
 	AppendRawData(fd.data, fd.size);
 	AppendRawData(regs, sizeof(*regs));
+
+	m_stream_offset = sizeof(fake_crc) + sizeof(header_size) + header_size + fd.size + sizeof(*regs);
+	m_frame_index.push_back({m_stream_offset, m_packets});
 }
 
 void GSDumpBase::Transfer(int index, const u8* mem, size_t size)
@@ -77,6 +91,9 @@ void GSDumpBase::Transfer(int index, const u8* mem, size_t size)
 	AppendRawData(static_cast<u8>(index));
 	AppendRawData(&size, 4);
 	AppendRawData(mem, size);
+
+	m_stream_offset += 1 + 1 + 4 + size;
+	m_packets++;
 }
 
 void GSDumpBase::ReadFIFO(u32 size)
@@ -86,6 +103,9 @@ void GSDumpBase::ReadFIFO(u32 size)
 
 	AppendRawData(2);
 	AppendRawData(&size, 4);
+
+	m_stream_offset += 1 + 4;
+	m_packets++;
 }
 
 bool GSDumpBase::VSync(int field, bool last, const GSPrivRegSet* regs)
@@ -100,6 +120,10 @@ bool GSDumpBase::VSync(int field, bool last, const GSPrivRegSet* regs)
 	AppendRawData(1);
 	AppendRawData(static_cast<u8>(field));
 
+	m_stream_offset += 1 + sizeof(*regs) + 1 + 1;
+	m_packets += 2;
+	m_frame_index.push_back({m_stream_offset, m_packets});
+
 	if (last)
 		m_extra_frames--;
 
@@ -114,6 +138,13 @@ void GSDumpBase::Write(const void* data, size_t size)
 	size_t written = fwrite(data, 1, size, m_gs);
 	if (written != size)
 		Console.Error("GSDump: Error failed to write data");
+
+	m_compressed_offset += written;
+}
+
+void GSDumpBase::AddSeekPoint(u64 uncompressed_offset)
+{
+	m_seek_points.push_back({m_compressed_offset, uncompressed_offset});
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -221,6 +252,8 @@ namespace
 {
 	class GSDumpXz final : public GsDumpBuffered
 	{
+		static constexpr u64 BLOCK_SIZE = 16 * _1mb;
+
 		void Compress();
 
 	public:
@@ -286,6 +319,9 @@ namespace
 
 		CXzProps props;
 		XzProps_Init(&props);
+
+		// Split the stream into blocks, so the replayer can decompress a range of frames without the whole dump.
+		props.blockSize = BLOCK_SIZE;
 		const SRes res = Xz_Encode(&dos.vt, &mis.vt, &props, nullptr);
 		if (res != SZ_OK)
 		{
@@ -313,7 +349,12 @@ namespace
 {
 	class GSDumpZst final : public GSDumpBase
 	{
+		// Frames are ended after this much data, each frame can be decompressed independently.
+		static constexpr u64 FRAME_SIZE = 16 * _1mb;
+
 		ZSTD_CStream* m_strm;
+		u64 m_uncompressed_size = 0;
+		u64 m_frame_size = 0;
 
 		std::vector<u8> m_in_buff;
 		std::vector<u8> m_out_buff;
@@ -370,8 +411,19 @@ namespace
 
 	void GSDumpZst::MayFlush()
 	{
-		if (m_in_buff.size() >= _1mb)
+		if (m_in_buff.size() < _1mb)
+			return;
+
+		m_frame_size += m_in_buff.size();
+		if (m_frame_size < FRAME_SIZE)
+		{
 			Compress(ZSTD_e_continue);
+			return;
+		}
+
+		Compress(ZSTD_e_end);
+		AddSeekPoint(m_uncompressed_size);
+		m_frame_size = 0;
 	}
 
 	void GSDumpZst::Compress(ZSTD_EndDirective action)
@@ -412,6 +464,7 @@ namespace
 			}
 		}
 
+		m_uncompressed_size += m_in_buff.size();
 		m_in_buff.clear();
 	}
 } // namespace
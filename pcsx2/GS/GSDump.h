@@ -4,6 +4,7 @@
 #pragma once
 
 #include "SaveState.h"
+#include "GS/GSLzma.h"
 #include "GS/GSRegs.h"
 #include "GS/Renderers/SW/GSVertexSW.h"
 
@@ -48,12 +49,23 @@ class GSDumpBase
 	int m_frames;
 	int m_extra_frames;
 
+	// Frame index, written next to the dump once it's complete.
+	std::vector<GSDumpFile::FrameIndexEntry> m_frame_index;
+	std::vector<GSDumpFile::SeekPoint> m_seek_points;
+	u64 m_stream_offset = 0;
+	u64 m_packets = 0;
+	u64 m_compressed_offset = 0;
+
 protected:
 	void AddHeader(const std::string& serial, u32 crc,
 		u32 screenshot_width, u32 screenshot_height, const u32* screenshot_pixels,
 		const freezeData& fd, const GSPrivRegSet* regs);
 	void Write(const void* data, size_t size);
 
+	/// Records that decompression can restart at the current file position,
+	/// at the given offset in the uncompressed stream.
+	void AddSeekPoint(u64 uncompressed_offset);
+
 	virtual void AppendRawData(const void* data, size_t size) = 0;
 	virtual void AppendRawData(u8 c) = 0;
 
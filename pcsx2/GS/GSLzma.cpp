@@ -8,6 +8,7 @@
 #include "common/BitUtils.h"
 #include "common/Error.h"
 #include "common/HeapArray.h"
+#include "common/Timer.h"
 
 #include "GS/GSDump.h"
 #include "GS/GSLzma.h"
@@ -21,7 +22,9 @@
 #include <XzCrc64.h>
 #include <zstd.h>
 
+#include <algorithm>
 #include <mutex>
+#include <optional>
 
 using namespace GSDumpTypes;
 
@@ -70,7 +73,7 @@ bool GSDumpFile::GetPreviewImageFromDump(const char* filename, u32* width, u32*
 	return true;
 }
 
-bool GSDumpFile::ReadFile(Error* error)
+bool GSDumpFile::ReadHeader(Error* error)
 {
 	u32 ss;
 	if (Read(&m_crc, sizeof(m_crc)) != sizeof(m_crc) || Read(&ss, sizeof(ss)) != sizeof(ss))
@@ -128,6 +131,14 @@ bool GSDumpFile::ReadFile(Error* error)
 		return false;
 	}
 
+	return true;
+}
+
+bool GSDumpFile::ReadFile(Error* error)
+{
+	if (!ReadHeader(error))
+		return false;
+
 	// read all the packet data in
 	// TODO: make this suck less by getting the full/extracted size and preallocating
 	for (;;)
@@ -151,9 +162,16 @@ bool GSDumpFile::ReadFile(Error* error)
 		}
 	}
 
+	return ParsePackets(error);
+}
+
+bool GSDumpFile::ParsePackets(Error* error)
+{
 	u8* data = m_packet_data.data();
 	size_t remaining = m_packet_data.size();
 
+	m_dump_packets.clear();
+
 #define GET_BYTE(dst) \
 	do \
 	{ \
@@ -232,6 +250,248 @@ bool GSDumpFile::ReadFile(Error* error)
 	return true;
 }
 
+bool GSDumpFile::Skip(u64 size)
+{
+	u8 buffer[16384];
+	while (size > 0)
+	{
+		const size_t chunk = static_cast<size_t>(std::min<u64>(size, sizeof(buffer)));
+		if (Read(buffer, chunk) != chunk)
+			return false;
+
+		size -= chunk;
+	}
+
+	return true;
+}
+
+/******************************************************************/
+
+// Frame index file format is:
+// - [GSDUMP_INDEX_ID_LEN] GSDUMP_INDEX_ID (no \0)
+// - [sizeof(GSDumpFrameIndexHeader)] header, describing the index and the dump it was built from
+// - [frames * sizeof(FrameIndexEntry)] start of each frame, plus the end of the stream
+// - [seek_points * sizeof(SeekPoint)] restart points for formats which can't seek on their own
+#define GSDUMP_INDEX_ID "PCSX2.gsdump.frameindex.v1|"
+#define GSDUMP_INDEX_ID_LEN (sizeof(GSDUMP_INDEX_ID) - 1)
+
+struct GSDumpFrameIndexHeader
+{
+	u32 frames;
+	u32 seek_points;
+	s64 source_size; // size of the dump, to detect stale indices
+	s64 source_mtime; // modification time of the dump
+};
+
+std::string GSDumpFile::GetFrameIndexPath(const char* filename)
+{
+	return fmt::format("{}.findex", filename);
+}
+
+bool GSDumpFile::WriteFrameIndex(const char* filename, const std::vector<FrameIndexEntry>& frames,
+	const std::vector<SeekPoint>& seek_points, Error* error)
+{
+	FILESYSTEM_STAT_DATA sd;
+	if (!FileSystem::StatFile(filename, &sd))
+	{
+		Error::SetStringFmt(error, "Failed to stat '{}'", filename);
+		return false;
+	}
+
+	GSDumpFrameIndexHeader header = {};
+	header.frames = static_cast<u32>(frames.size());
+	header.seek_points = static_cast<u32>(seek_points.size());
+	header.source_size = sd.Size;
+	header.source_mtime = sd.ModificationTime;
+
+	return FileSystem::WriteAtomicRenamedFile(GetFrameIndexPath(filename).c_str(), [&](std::FILE* fp) {
+		return std::fwrite(GSDUMP_INDEX_ID, GSDUMP_INDEX_ID_LEN, 1, fp) == 1 &&
+			   std::fwrite(&header, sizeof(header), 1, fp) == 1 &&
+			   (frames.empty() || std::fwrite(frames.data(), sizeof(FrameIndexEntry) * frames.size(), 1, fp) == 1) &&
+			   (seek_points.empty() || std::fwrite(seek_points.data(), sizeof(SeekPoint) * seek_points.size(), 1, fp) == 1);
+	}, error);
+}
+
+bool GSDumpFile::LoadFrameIndex(const char* filename)
+{
+	const std::string index_filename = GetFrameIndexPath(filename);
+	std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(index_filename.c_str());
+	if (!data.has_value())
+		return false;
+
+	GSDumpFrameIndexHeader header;
+	if (data->size() < (GSDUMP_INDEX_ID_LEN + sizeof(header)) ||
+		std::memcmp(data->data(), GSDUMP_INDEX_ID, GSDUMP_INDEX_ID_LEN) != 0)
+	{
+		Console.ErrorFmt("(GSDump) Incompatible frame index: '{}'", index_filename);
+		return false;
+	}
+
+	std::memcpy(&header, data->data() + GSDUMP_INDEX_ID_LEN, sizeof(header));
+	const size_t expected_size = GSDUMP_INDEX_ID_LEN + sizeof(header) + sizeof(FrameIndexEntry) * header.frames +
+								 sizeof(SeekPoint) * header.seek_points;
+	if (header.frames < 2 || data->size() != expected_size)
+	{
+		Console.ErrorFmt("(GSDump) Unexpected size of frame index: '{}'", index_filename);
+		return false;
+	}
+
+	FILESYSTEM_STAT_DATA sd;
+	if (!FileSystem::StatFile(m_fp.get(), &sd) || sd.Size != header.source_size ||
+		sd.ModificationTime != header.source_mtime)
+	{
+		Console.WarningFmt("(GSDump) Frame index '{}' is out of date, it will be rebuilt.", index_filename);
+		return false;
+	}
+
+	const u8* ptr = data->data() + GSDUMP_INDEX_ID_LEN + sizeof(header);
+	m_frames.resize(header.frames);
+	std::memcpy(m_frames.data(), ptr, sizeof(FrameIndexEntry) * header.frames);
+	ptr += sizeof(FrameIndexEntry) * header.frames;
+	m_seek_points.resize(header.seek_points);
+	if (header.seek_points > 0)
+		std::memcpy(m_seek_points.data(), ptr, sizeof(SeekPoint) * header.seek_points);
+
+	// Must line up with the header we just read.
+	if (m_frames.front().offset != GetPosition())
+	{
+		Console.ErrorFmt("(GSDump) Frame index '{}' does not match the dump.", index_filename);
+		m_frames.clear();
+		m_seek_points.clear();
+		return false;
+	}
+
+	return true;
+}
+
+bool GSDumpFile::BuildFrameIndex(Error* error)
+{
+	Common::Timer timer;
+
+	u64 pos = GetPosition();
+	u64 packet = 0;
+
+	m_frames.clear();
+	m_frames.push_back({pos, packet});
+
+	for (;;)
+	{
+		GSType id;
+		if (Read(&id, sizeof(id)) != sizeof(id))
+			break;
+
+		u64 length;
+		u64 header_length = sizeof(id);
+		switch (id)
+		{
+			case GSType::Transfer:
+			{
+				u8 path;
+				u32 transfer_length;
+				if (Read(&path, sizeof(path)) != sizeof(path) ||
+					Read(&transfer_length, sizeof(transfer_length)) != sizeof(transfer_length))
+				{
+					length = UINT64_MAX;
+					break;
+				}
+
+				header_length += sizeof(path) + sizeof(transfer_length);
+				length = transfer_length;
+			}
+			break;
+			case GSType::VSync:
+				length = 1;
+				break;
+			case GSType::ReadFIFO2:
+				length = 4;
+				break;
+			case GSType::Registers:
+				length = 8192;
+				break;
+			default:
+				Error::SetStringFmt(error,
+					TRANSLATE_FS("GSDumpFile", "Unknown packet type {}"), static_cast<u32>(id));
+				return false;
+		}
+
+		// Same as ParsePackets(), a truncated last packet is dropped.
+		if (length == UINT64_MAX || !Skip(length))
+			break;
+
+		pos += header_length + length;
+		packet++;
+
+		if (id == GSType::VSync)
+			m_frames.push_back({pos, packet});
+	}
+
+	if (m_frames.back().offset != pos)
+		m_frames.push_back({pos, packet});
+
+	if (m_frames.size() < 2)
+	{
+		Error::SetString(error, TRANSLATE_STR("GSDumpFile", "Dump contains no packets."));
+		return false;
+	}
+
+	DevCon.WriteLnFmt("(GSDump) Indexed {} frames with {} packets in {:.2f} ms", m_frames.size() - 1, packet,
+		timer.GetTimeMilliseconds());
+	return true;
+}
+
+bool GSDumpFile::ReadHeaderAndIndex(const char* filename, Error* error)
+{
+	if (!ReadHeader(error))
+		return false;
+
+	if (LoadFrameIndex(filename))
+		return true;
+
+	if (!BuildFrameIndex(error))
+		return false;
+
+	// Not being able to cache the index (e.g. a read-only directory) isn't fatal.
+	Error index_error;
+	if (!WriteFrameIndex(filename, m_frames, m_seek_points, &index_error))
+		Console.WarningFmt("(GSDump) Not saving frame index: {}", index_error.GetDescription());
+
+	return true;
+}
+
+bool GSDumpFile::ReadFrames(u32 first_frame, u32 num_frames, Error* error)
+{
+	const u32 frame_count = GetFrameCount();
+	if (first_frame >= frame_count)
+	{
+		Error::SetStringFmt(error, "Frame {} is out of range.", first_frame);
+		return false;
+	}
+
+	num_frames = std::min(num_frames, frame_count - first_frame);
+
+	const u64 start = m_frames[first_frame].offset;
+	const u64 size = m_frames[first_frame + num_frames].offset - start;
+	if (!Seek(start))
+	{
+		Error::SetStringFmt(error, "Failed to seek to frame {}.", first_frame);
+		return false;
+	}
+
+	m_packet_data.resize(static_cast<size_t>(size));
+	if (Read(m_packet_data.data(), m_packet_data.size()) != m_packet_data.size())
+	{
+		Error::SetString(error, TRANSLATE_STR("GSDumpFile", "Failed to read packet."));
+		return false;
+	}
+
+	if (!ParsePackets(error))
+		return false;
+
+	m_first_loaded_frame = first_frame;
+	m_loaded_frame_count = num_frames;
+	return true;
+}
+
 /******************************************************************/
 
 static std::once_flag s_lzma_crc_table_init;
@@ -256,6 +516,8 @@ namespace
 		bool Open(FileSystem::ManagedCFilePtr fp, Error* error) override;
 		bool IsEof() override;
 		size_t Read(void* ptr, size_t size) override;
+		u64 GetPosition() override;
+		bool Seek(u64 offset) override;
 
 	private:
 		static constexpr size_t kInputBufSize = static_cast<size_t>(1) << 18;
@@ -466,6 +728,38 @@ namespace
 		return size - remain;
 	}
 
+	u64 GSDumpLzma::GetPosition()
+	{
+		return (m_block_index > 0) ? (m_blocks[m_block_index - 1].stream_offset + m_block_pos) : 0;
+	}
+
+	bool GSDumpLzma::Seek(u64 offset)
+	{
+		if (offset >= m_stream_size)
+		{
+			m_block_index = m_blocks.size();
+			m_block_size = 0;
+			m_block_pos = 0;
+			return (offset == m_stream_size);
+		}
+
+		// Find the block containing the offset, only decompressing it if it's not the current one.
+		const auto it = std::upper_bound(m_blocks.begin(), m_blocks.end(), offset,
+			[](u64 offset, const Block& block) { return offset < block.stream_offset; });
+		const size_t index = static_cast<size_t>(std::distance(m_blocks.begin(), it)) - 1;
+		if (m_block_index != (index + 1) || m_block_size == 0)
+		{
+			m_block_index = index;
+			m_block_size = 0;
+			m_block_pos = 0;
+			if (!DecompressNextBlock())
+				return false;
+		}
+
+		m_block_pos = static_cast<size_t>(offset - m_blocks[index].stream_offset);
+		return true;
+	}
+
 	/******************************************************************/
 
 	class GSDumpDecompressZst final : public GSDumpFile
@@ -481,7 +775,12 @@ namespace
 		size_t m_avail = 0;
 		size_t m_start = 0;
 
+		// Offsets of the start of m_area in the decompressed stream, and m_inbuf in the file.
+		u64 m_area_offset = 0;
+		u64 m_inbuf_offset = 0;
+
 		bool Decompress();
+		void AddSeekPoint(u64 compressed_offset, u64 uncompressed_offset);
 
 	public:
 		GSDumpDecompressZst();
@@ -490,6 +789,8 @@ namespace
 		bool Open(FileSystem::ManagedCFilePtr fp, Error* error) override;
 		bool IsEof() override;
 		size_t Read(void* ptr, size_t size) override;
+		u64 GetPosition() override;
+		bool Seek(u64 offset) override;
 	};
 
 	GSDumpDecompressZst::GSDumpDecompressZst() = default;
@@ -521,12 +822,15 @@ namespace
 
 	bool GSDumpDecompressZst::Decompress()
 	{
+		m_area_offset += m_start + m_avail;
+
 		ZSTD_outBuffer outbuf = {m_area, OUTPUT_BUFFER_SIZE, 0};
 		while (outbuf.pos == 0)
 		{
 			// Nothing left in the input buffer. Read data from the file
 			if (m_inbuf.pos == m_inbuf.size && !std::feof(m_fp.get()))
 			{
+				m_inbuf_offset += m_inbuf.size;
 				m_inbuf.size = fread(const_cast<void*>(m_inbuf.src), 1, INPUT_BUFFER_SIZE, m_fp.get());
 				m_inbuf.pos = 0;
 
@@ -543,6 +847,10 @@ namespace
 				Console.Error("Decoder error: (error code %s)", ZSTD_getErrorName(ret));
 				return false;
 			}
+
+			// End of a frame, decompression can be restarted from here later.
+			if (ret == 0)
+				AddSeekPoint(m_inbuf_offset + m_inbuf.pos, m_area_offset + outbuf.pos);
 		}
 
 		m_start = 0;
@@ -578,6 +886,56 @@ namespace
 		return off;
 	}
 
+	void GSDumpDecompressZst::AddSeekPoint(u64 compressed_offset, u64 uncompressed_offset)
+	{
+		const auto it = std::lower_bound(m_seek_points.begin(), m_seek_points.end(), uncompressed_offset,
+			[](const SeekPoint& sp, u64 offset) { return sp.uncompressed_offset < offset; });
+		if (it == m_seek_points.end() || it->uncompressed_offset != uncompressed_offset)
+			m_seek_points.insert(it, {compressed_offset, uncompressed_offset});
+	}
+
+	u64 GSDumpDecompressZst::GetPosition()
+	{
+		return m_area_offset + m_start;
+	}
+
+	bool GSDumpDecompressZst::Seek(u64 offset)
+	{
+		// Still in the buffer?
+		if (offset >= m_area_offset && offset <= (m_area_offset + m_start + m_avail))
+		{
+			const size_t new_start = static_cast<size_t>(offset - m_area_offset);
+			m_avail = (m_start + m_avail) - new_start;
+			m_start = new_start;
+			return true;
+		}
+
+		// Zstd can't seek within a frame, so go back to the last frame starting before the offset,
+		// unless we're already past it, in which case decompressing forward is cheaper.
+		SeekPoint restart = {};
+		const auto it = std::upper_bound(m_seek_points.begin(), m_seek_points.end(), offset,
+			[](u64 offset, const SeekPoint& sp) { return offset < sp.uncompressed_offset; });
+		if (it != m_seek_points.begin())
+			restart = *(it - 1);
+
+		const u64 position = GetPosition();
+		if (offset < position || restart.uncompressed_offset > position)
+		{
+			if (FileSystem::FSeek64(m_fp.get(), static_cast<s64>(restart.compressed_offset), SEEK_SET) != 0)
+				return false;
+
+			ZSTD_DCtx_reset(m_strm, ZSTD_reset_session_only);
+			m_inbuf.pos = 0;
+			m_inbuf.size = 0;
+			m_inbuf_offset = restart.compressed_offset;
+			m_area_offset = restart.uncompressed_offset;
+			m_start = 0;
+			m_avail = 0;
+		}
+
+		return Skip(offset - GetPosition());
+	}
+
 	/******************************************************************/
 
 	class GSDumpRaw final : public GSDumpFile
@@ -589,6 +947,8 @@ namespace
 		bool Open(FileSystem::ManagedCFilePtr fp, Error* error) override;
 		bool IsEof() override;
 		size_t Read(void* ptr, size_t size) override;
+		u64 GetPosition() override;
+		bool Seek(u64 offset) override;
 	};
 
 	GSDumpRaw::GSDumpRaw() = default;
@@ -616,6 +976,16 @@ namespace
 
 		return ret;
 	}
+
+	u64 GSDumpRaw::GetPosition()
+	{
+		return static_cast<u64>(std::max<s64>(FileSystem::FTell64(m_fp.get()), 0));
+	}
+
+	bool GSDumpRaw::Seek(u64 offset)
+	{
+		return (FileSystem::FSeek64(m_fp.get(), static_cast<s64>(offset), SEEK_SET) == 0);
+	}
 } // namespace
 
 /******************************************************************/
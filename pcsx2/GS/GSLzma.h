@@ -280,6 +280,21 @@ public:
 		GSDumpTypes::GSTransferPath path;
 	};
 
+	/// Where a frame starts in the decompressed stream, and the index of its first packet.
+	/// Each frame runs up to and including its VSync packet.
+	struct FrameIndexEntry
+	{
+		u64 offset;
+		u64 packet;
+	};
+
+	/// A position where decompression can restart without decoding anything before it.
+	struct SeekPoint
+	{
+		u64 compressed_offset;
+		u64 uncompressed_offset;
+	};
+
 	using ByteArray = std::vector<u8>;
 	using GSDataArray = std::vector<GSData>;
 
@@ -288,6 +303,11 @@ public:
 	static std::unique_ptr<GSDumpFile> OpenGSDump(const char* filename, Error* error = nullptr);
 	static bool GetPreviewImageFromDump(const char* filename, u32* width, u32* height, std::vector<u32>* pixels);
 
+	/// Frame indices are cached next to the dump, and are written when the dump is created.
+	static std::string GetFrameIndexPath(const char* filename);
+	static bool WriteFrameIndex(const char* filename, const std::vector<FrameIndexEntry>& frames,
+		const std::vector<SeekPoint>& seek_points, Error* error);
+
 	__fi const std::string& GetSerial() const { return m_serial; }
 	__fi u32 GetCRC() const { return m_crc; }
 
@@ -295,8 +315,19 @@ public:
 	__fi const ByteArray& GetStateData() const { return m_state_data; }
 	__fi const GSDataArray& GetPackets() const { return m_dump_packets; }
 
+	/// Reads the whole dump into memory.
 	bool ReadFile(Error* error);
 
+	/// Reads the header and the frame index (building and caching it if needed), but no packets.
+	/// Packets are then pulled in a range of frames at a time with ReadFrames().
+	bool ReadHeaderAndIndex(const char* filename, Error* error);
+	bool ReadFrames(u32 first_frame, u32 num_frames, Error* error);
+
+	__fi u32 GetFrameCount() const { return m_frames.empty() ? 0 : static_cast<u32>(m_frames.size() - 1); }
+	__fi const FrameIndexEntry& GetFrameIndexEntry(u32 frame) const { return m_frames[frame]; }
+	__fi u32 GetFirstLoadedFrame() const { return m_first_loaded_frame; }
+	__fi u32 GetLoadedFrameCount() const { return m_loaded_frame_count; }
+
 protected:
 	GSDumpFile();
 
@@ -304,10 +335,24 @@ protected:
 	virtual bool IsEof() = 0;
 	virtual size_t Read(void* ptr, size_t size) = 0;
 
+	/// Position in, and seeking within, the decompressed stream.
+	virtual u64 GetPosition() = 0;
+	virtual bool Seek(u64 offset) = 0;
+
+	bool Skip(u64 size);
+
 protected:
 	FileSystem::ManagedCFilePtr m_fp;
 
+	/// Only used by formats which can't seek on their own.
+	std::vector<SeekPoint> m_seek_points;
+
 private:
+	bool ReadHeader(Error* error);
+	bool ParsePackets(Error* error);
+	bool LoadFrameIndex(const char* filename);
+	bool BuildFrameIndex(Error* error);
+
 	std::string m_serial;
 	u32 m_crc = 0;
 
@@ -316,6 +361,11 @@ private:
 	std::vector<u8> m_packet_data;
 
 	GSDataArray m_dump_packets;
+
+	/// One entry per frame, plus one for the end of the stream.
+	std::vector<FrameIndexEntry> m_frames;
+	u32 m_first_loaded_frame = 0;
+	u32 m_loaded_frame_count = 0;
 };
 
 // Initializes CRC tables used by LZMA SDK.
@@ -7,6 +7,7 @@
 
 #include <ctime>
 #include <string>
+#include <vector>
 
 class GSPerfMon
 {
@@ -26,6 +27,8 @@ public:
 		TextureCopiesROV, // Overlaps with regular texture copies.
 		DrawCallsROV, // Overlaps with regular draw calls.
 		BarriersROV, // Overlaps with regular barriers.
+		SourceLookupHits, // Texture cache lookups resolved by the hashed index.
+		SourceLookupMisses, // Texture cache lookups which fell back to walking the page list.
 		CounterLast,
 
 		// Reused counters for HW.
@@ -43,6 +46,8 @@ protected:
 	clock_t m_lastframe = 0;
 	int m_count = 0;
 	int m_disp_fb_sprite_blits = 0;
+	bool m_draw_timing = false;
+	std::vector<float> m_draw_times;
 
 public:
 	GSPerfMon();
@@ -66,6 +71,17 @@ public:
 		return blits;
 	}
 
+	/// Per-draw CPU time collection, off unless something (e.g. the GS runner's benchmark mode) asks for it.
+	/// Times are in microseconds, and accumulate until taken.
+	void SetDrawTimingEnabled(bool enabled) { m_draw_timing = enabled; }
+	__fi bool IsDrawTimingEnabled() const { return m_draw_timing; }
+	void AddDrawTime(float us) { m_draw_times.push_back(us); }
+	void TakeDrawTimes(std::vector<float>* times)
+	{
+		times->swap(m_draw_times);
+		m_draw_times.clear();
+	}
+
 	GSPerfMon operator-(const GSPerfMon& other);
 
 	void Dump(const std::string& filename, bool hw);
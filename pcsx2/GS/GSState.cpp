@@ -11,6 +11,7 @@
 #include "common/BitUtils.h"
 #include "common/Path.h"
 #include "common/StringUtil.h"
+#include "common/Timer.h"
 
 #include <algorithm>
 #include <cfloat>
@@ -2640,7 +2641,19 @@ void GSState::FlushPrim()
 		}
 
 		if (!skip_draw)
-			Draw();
+		{
+			if (g_perfmon.IsDrawTimingEnabled()) [[unlikely]]
+			{
+				const Common::Timer::Value start = Common::Timer::GetCurrentValue();
+				Draw();
+				g_perfmon.AddDrawTime(static_cast<float>(
+					Common::Timer::ConvertValueToNanoseconds(Common::Timer::GetCurrentValue() - start) / 1000.0));
+			}
+			else
+			{
+				Draw();
+			}
+		}
 
 		g_perfmon.Put(GSPerfMon::Draw, 1);
 		g_perfmon.Put(GSPerfMon::Prim, idx_buff.tail / GSUtil::GetVertexCount(PRIM->PRIM));
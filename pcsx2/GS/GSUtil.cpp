@@ -190,7 +190,12 @@ const char* GSUtil::GetPerfMonCounterName(GSPerfMon::counter_t counter, bool hw)
 			"TextureCopies",
 			"TextureUploads",
 			"Barriers",
-			"RenderPasses"
+			"RenderPasses",
+			"TextureCopiesROV",
+			"DrawCallsROV",
+			"BarriersROV",
+			"SourceLookupHits",
+			"SourceLookupMisses"
 		};
 		return counter < std::size(names_hw) ? names_hw[counter] : "";
 	}
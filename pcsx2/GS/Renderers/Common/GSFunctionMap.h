@@ -9,6 +9,7 @@
 #include "common/HostSys.h"
 
 #include <cinttypes>
+#include <unordered_set>
 
 template <class KEY, class VALUE>
 class GSFunctionMap
@@ -142,6 +143,7 @@ namespace GSCodeReserve
 	void ResetMemory();
 
 	size_t GetMemoryUsed();
+	size_t GetMemoryAvailable();
 
 	u8* ReserveMemory(size_t size);
 	void CommitMemory(size_t size);
@@ -153,6 +155,10 @@ class GSCodeGeneratorFunctionMap : public GSFunctionMap<KEY, VALUE>
 	std::string m_name;
 	std::unordered_map<u64, VALUE> m_cgmap;
 
+	// Every key generated, or loaded to be pregenerated. Survives Clear(), so it can be saved per game.
+	std::unordered_set<KEY> m_profile;
+	bool m_profile_dirty = false;
+
 	enum { MAX_SIZE = 8192 };
 
 public:
@@ -168,6 +174,25 @@ public:
 		m_cgmap.clear();
 	}
 
+	const std::unordered_set<KEY>& GetProfile() const { return m_profile; }
+	bool IsProfileDirty() const { return m_profile_dirty; }
+
+	void AddToProfile(KEY key)
+	{
+		m_profile.insert(key);
+	}
+
+	void ClearProfile()
+	{
+		m_profile.clear();
+		m_profile_dirty = false;
+	}
+
+	bool IsGenerated(KEY key) const
+	{
+		return m_cgmap.find(key) != m_cgmap.end();
+	}
+
 	VALUE GetDefaultFunction(KEY key)
 	{
 		VALUE ret = nullptr;
@@ -202,6 +227,9 @@ public:
 			ret = (VALUE)cg.GetCode();
 
 			m_cgmap[key] = ret;
+
+			if (m_profile.insert(key).second)
+				m_profile_dirty = true;
 		}
 
 		return ret;
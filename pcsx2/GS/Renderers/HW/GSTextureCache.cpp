@@ -29,6 +29,7 @@
 std::unique_ptr<GSTextureCache> g_texture_cache;
 
 static u8* s_unswizzle_buffer;
+static thread_local u8* s_async_hash_buffer;
 
 /// List of candidates for purging when the hash cache gets too large.
 static std::vector<std::pair<GSTextureCache::HashCacheMap::iterator, s32>> s_hash_cache_purge_list;
@@ -60,6 +61,9 @@ GSTextureCache::GSTextureCache()
 
 GSTextureCache::~GSTextureCache()
 {
+	// Workers may still be reading local memory.
+	m_async_hash_workers.clear();
+
 	RemoveAll(true, true, true);
 
 	s_hash_cache_purge_list = {};
@@ -107,6 +111,7 @@ void GSTextureCache::RemoveAll(bool sources, bool targets, bool hash_cache)
 			g_gs_device->Recycle(it.second.texture);
 
 		m_hash_cache.clear();
+		m_async_hashes.clear();
 		m_hash_cache_memory_usage = 0;
 		m_hash_cache_replacement_memory_usage = 0;
 	}
@@ -1057,76 +1062,130 @@ void GSTextureCache::DirtyRectByPage(u32 sbp, u32 spsm, u32 sbw, Target* t, GSVe
 	}
 }
 
-__ri static GSTextureCache::Source* FindSourceInMap(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA,
+__ri static bool SourceMatchesLookup(GSTextureCache::Source* s, const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA,
 	const GSLocalMemory::psm_t& psm_s, const u32* clut, const GSTexture* gpu_clut, const GSVector2i& compare_lod,
-	const GSTextureCache::SourceRegion& region, u32 fixed_tex0, FastList<GSTextureCache::Source*>& map, const GIFRegCLAMP& CLAMP, GSVector4i read_area)
+	const GSTextureCache::SourceRegion& region, u32 fixed_tex0, const GIFRegCLAMP& CLAMP, const GSVector4i& read_area)
 {
-	GSTextureCache::Source* best_s = nullptr;
+	if (((TEX0.U32[0] ^ s->m_TEX0.U32[0]) | ((TEX0.U32[1] ^ s->m_TEX0.U32[1]) & 3)) != 0) // TBP0 TBW PSM TW TH
+		return false;
 
-	for (auto i = map.begin(); i != map.end(); ++i)
+	// Target are converted (AEM & palette) on the fly by the GPU. They don't need extra check
+	if (!s->m_target)
 	{
-		GSTextureCache::Source* s = *i;
-		if (((TEX0.U32[0] ^ s->m_TEX0.U32[0]) | ((TEX0.U32[1] ^ s->m_TEX0.U32[1]) & 3)) != 0) // TBP0 TBW PSM TW TH
-			continue;
+		if (psm_s.pal > 0)
+		{
+			// If we're doing GPU CLUT, we don't want to use the CPU-converted version.
+			if (gpu_clut && !s->m_palette)
+				return false;
+
+			// We request a palette texture (psm_s.pal). If the texture was
+			// converted by the CPU (!s->m_palette), we need to ensure
+			// palette content is the same.
+			if (!s->m_palette && !s->ClutMatch({clut, psm_s.pal}))
+				return false;
+		}
+		else
+		{
+			// We request a 24/16 bit RGBA texture. Alpha expansion was done by
+			// the CPU.  We need to check that TEXA is identical
+			if (psm_s.fmt > 0 && s->m_TEXA.U64 != TEXA.U64)
+				return false;
+		}
 
-		// Target are converted (AEM & palette) on the fly by the GPU. They don't need extra check
-		if (!s->m_target)
+		// When fixed tex0 is used, we must find a matching region texture. The base likely
+		// doesn't contain to the correct region. Bit cheeky here, avoid a logical or by
+		// adding the invalid tex0 bit in.
+		
+		if (((s->m_region.bits | fixed_tex0) != 0))
 		{
-			if (psm_s.pal > 0)
+			const bool is_clamped = CLAMP.WMS == CLAMP_CLAMP && CLAMP.WMT == CLAMP_CLAMP;
+			if (is_clamped && s->m_region.GetMinX() == 0 && s->m_region.GetMinY() == 0)
 			{
-				// If we're doing GPU CLUT, we don't want to use the CPU-converted version.
-				if (gpu_clut && !s->m_palette)
-					continue;
+				const GSVector4i read_region = GSVector4i(0, 0, read_area.z, read_area.w);
+				const GSVector4i region_area = GSVector4i(s->m_region.GetMinX(), s->m_region.GetMinY(), s->m_region.HasX() ? s->m_region.GetMaxX() : (1 << s->m_TEX0.TW), s->m_region.HasY() ? s->m_region.GetMaxY() : (1 << s->m_TEX0.TW));
 
-				// We request a palette texture (psm_s.pal). If the texture was
-				// converted by the CPU (!s->m_palette), we need to ensure
-				// palette content is the same.
-				if (!s->m_palette && !s->ClutMatch({clut, psm_s.pal}))
-					continue;
+				if (!region_area.rintersect(read_region).eq(read_region))
+					return false;
 			}
-			else
+			else if (((s->m_region.bits | fixed_tex0) != 0) && s->m_region.bits != region.bits)
 			{
-				// We request a 24/16 bit RGBA texture. Alpha expansion was done by
-				// the CPU.  We need to check that TEXA is identical
-				if (psm_s.fmt > 0 && s->m_TEXA.U64 != TEXA.U64)
-					continue;
+				return false;
 			}
+		}
 
-			// When fixed tex0 is used, we must find a matching region texture. The base likely
-			// doesn't contain to the correct region. Bit cheeky here, avoid a logical or by
-			// adding the invalid tex0 bit in.
-			
-			if (((s->m_region.bits | fixed_tex0) != 0))
-			{
-				const bool is_clamped = CLAMP.WMS == CLAMP_CLAMP && CLAMP.WMT == CLAMP_CLAMP;
-				if (is_clamped && s->m_region.GetMinX() == 0 && s->m_region.GetMinY() == 0)
-				{
-					const GSVector4i read_region = GSVector4i(0, 0, read_area.z, read_area.w);
-					const GSVector4i region_area = GSVector4i(s->m_region.GetMinX(), s->m_region.GetMinY(), s->m_region.HasX() ? s->m_region.GetMaxX() : (1 << s->m_TEX0.TW), s->m_region.HasY() ? s->m_region.GetMaxY() : (1 << s->m_TEX0.TW));
+		// Same base mip texture, but we need to check that MXL was the same as well.
+		// When mipmapping is off, this will be 0,0 vs 0,0.
+		if (s->m_lod != compare_lod)
+			return false;
+	}
 
-					if (!region_area.rintersect(read_region).eq(read_region))
-						continue;
-				}
-				else if (((s->m_region.bits | fixed_tex0) != 0) && s->m_region.bits != region.bits)
-				{
-					continue;
-				}
-			}
+	return true;
+}
 
-			// Same base mip texture, but we need to check that MXL was the same as well.
-			// When mipmapping is off, this will be 0,0 vs 0,0.
-			if (s->m_lod != compare_lod)
-				continue;
+GSTextureCache::Source* GSTextureCache::SourceMap::Lookup(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA,
+	const GSLocalMemory::psm_t& psm_s, const u32* clut, const GSTexture* gpu_clut, const GSVector2i& compare_lod,
+	const SourceRegion& region, u32 fixed_tex0, u32 page, const GIFRegCLAMP& CLAMP, const GSVector4i& read_area)
+{
+	// Only sources with the exact same TEX0 can match, so nothing outside the bucket needs to be checked.
+	const u64 key = GetLookupKey(TEX0);
+	const auto bucket = m_lookup.find(key);
+	if (bucket == m_lookup.end())
+	{
+		g_perfmon.Put(GSPerfMon::SourceLookupMisses, 1);
+		return nullptr;
+	}
+
+	std::vector<Source*>& sources = bucket->second;
+	auto found = sources.end();
+	bool multiple_matches = false;
+	for (auto it = sources.begin(); it != sources.end(); ++it)
+	{
+		Source* s = *it;
+		if (!s->m_page_bits.test(page) ||
+			!SourceMatchesLookup(s, TEX0, TEXA, psm_s, clut, gpu_clut, compare_lod, region, fixed_tex0, CLAMP, read_area))
+		{
+			continue;
 		}
 
-		map.MoveFront(i.Index());
-		return s;
+		if (found != sources.end())
+		{
+			multiple_matches = true;
+			break;
+		}
+
+		found = it;
 	}
 
-	if (best_s != nullptr)
-		return best_s;
-	else
+	if (found == sources.end())
+	{
+		g_perfmon.Put(GSPerfMon::SourceLookupMisses, 1);
 		return nullptr;
+	}
+
+	// The bucket is ordered by use across all pages, but the page list is what decided the winner
+	// before the index existed. When more than one source matches, pick the first one in the page list.
+	Source* s = *found;
+	if (multiple_matches)
+	{
+		FastList<Source*>& list = m_map[page];
+		for (auto i = list.begin(); i != list.end(); ++i)
+		{
+			Source* candidate = *i;
+			if (candidate->m_lookup_key == key &&
+				SourceMatchesLookup(candidate, TEX0, TEXA, psm_s, clut, gpu_clut, compare_lod, region, fixed_tex0, CLAMP, read_area))
+			{
+				s = candidate;
+				found = std::find(sources.begin(), sources.end(), s);
+				break;
+			}
+		}
+	}
+
+	// Keep both the index and the page list in most recently used order.
+	std::rotate(sources.begin(), found, found + 1);
+	m_map[page].MoveFront(s->m_erase_it[page]);
+	g_perfmon.Put(GSPerfMon::SourceLookupHits, 1);
+	return s;
 }
 
 GSTextureCache::Source* GSTextureCache::LookupDepthSource(const bool is_depth, const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, const GIFRegCLAMP& CLAMP, const GSVector4i& r, const bool possible_shuffle, const bool linear, const GIFRegFRAME& frame, bool req_color, bool req_alpha, bool palette)
@@ -1145,8 +1204,8 @@ GSTextureCache::Source* GSTextureCache::LookupDepthSource(const bool is_depth, c
 	// Yes, this can get called with color PSMs that have palettes
 	const u32* const clut = g_gs_renderer->m_mem.m_clut;
 	GSTexture* const gpu_clut = (psm_s.pal > 0) ? g_gs_renderer->m_mem.m_clut.GetGPUTexture() : nullptr;
-	Source* src = FindSourceInMap(TEX0, TEXA, psm_s, clut, gpu_clut, GSVector2i(0, 0), region,
-		region.IsFixedTEX0(TEX0), m_src.m_map[TEX0.TBP0 >> 5], CLAMP, r);
+	Source* src = m_src.Lookup(TEX0, TEXA, psm_s, clut, gpu_clut, GSVector2i(0, 0), region,
+		region.IsFixedTEX0(TEX0), TEX0.TBP0 >> 5, CLAMP, r);
 	if (src)
 	{
 		GL_CACHE("TC: src hit: (0x%x, %s)", TEX0.TBP0, GSUtil::GetPSMName(TEX0.PSM));
@@ -1359,10 +1418,10 @@ GSTextureCache::Source* GSTextureCache::LookupSource(const bool is_color, const
 		const GSOffset offset(psm_s.info, TEX0.TBP0, TEX0.TBW, TEX0.PSM);
 		const u32 region_page = offset.bn(region.GetMinX(), region.GetMinY()) >> 5;
 		if (lookup_page != region_page)
-			src = FindSourceInMap(TEX0, TEXA, psm_s, clut, gpu_clut, compare_lod, region, is_fixed_tex0, m_src.m_map[region_page], CLAMP, r);
+			src = m_src.Lookup(TEX0, TEXA, psm_s, clut, gpu_clut, compare_lod, region, is_fixed_tex0, region_page, CLAMP, r);
 	}
 	if (!src)
-		src = FindSourceInMap(TEX0, TEXA, psm_s, clut, gpu_clut, compare_lod, region, is_fixed_tex0, m_src.m_map[lookup_page], CLAMP, r);
+		src = m_src.Lookup(TEX0, TEXA, psm_s, clut, gpu_clut, compare_lod, region, is_fixed_tex0, lookup_page, CLAMP, r);
 
 	if (src && src->m_from_target && GSConfig.UserHacks_TextureInsideRt >= GSTextureInRtMode::MergeTargets && GSLocalMemory::GetUnwrappedEndBlockAddress(TEX0.TBP0, TEX0.TBW, TEX0.PSM, r) > src->m_from_target->m_end_block)
 	{
@@ -4723,6 +4782,8 @@ void GSTextureCache::InvalidateVideoMem(const GSOffset& off, const GSVector4i& r
 	const u32 bw = off.bw();
 	const u32 psm = off.psm();
 
+	MarkPagesWritten(off, rect);
+
 	// Get the bounds that we're invalidating in blocks, so we can remove any targets which are completely contained.
 	// Unfortunately sometimes the draw rect is incorrect, and since the end block gets the rect -1, it'll underflow,
 	// so we need to prevent that from happening. Just make it a single block in that case, and hope for the best.
@@ -7005,9 +7066,22 @@ GSTextureCache::HashCacheEntry* GSTextureCache::LookupHashCache(const GIFRegTEX0
 	if (!dump && !replace && !can_cache)
 		return nullptr;
 
+	// Hashing large textures can take longer than uploading them, so do it on a worker thread, and upload directly
+	// until the hash is ready. Dumping and replacing need the hash immediately, and mipmaps depend on other registers.
+	const GSLocalMemory::psm_t& psm_s = GSLocalMemory::m_psm[TEX0.PSM];
+	const u32 tex_size = ((region.HasX() ? region.GetWidth() : (1u << TEX0.TW)) *
+							 (region.HasY() ? region.GetHeight() : (1u << TEX0.TH)) * psm_s.bpp) >> 3;
+	HashType async_hash = 0;
+	const bool use_async_hash = (can_cache && !dump && !replace && (!lod || lod->x == lod->y) &&
+								 tex_size >= ASYNC_HASH_MIN_TEXTURE_SIZE);
+	if (use_async_hash && !LookupAsyncHash(TEX0, TEXA, region, &async_hash))
+		return nullptr;
+
 	// need the hash either for replacing, dumping or caching.
 	// if dumping/replacing is on, we compute the clut hash regardless, since replacements aren't indexed
-	HashCacheKey key{HashCacheKey::Create(TEX0, TEXA, (dump || replace || !paltex) ? clut : nullptr, lod, region)};
+	HashCacheKey key{use_async_hash ?
+						 HashCacheKey::Create(TEX0, TEXA, !paltex ? clut : nullptr, region, async_hash) :
+						 HashCacheKey::Create(TEX0, TEXA, (dump || replace || !paltex) ? clut : nullptr, lod, region)};
 
 	// handle dumping first, this is mostly isolated.
 	if (dump)
@@ -7168,7 +7242,6 @@ void GSTextureCache::AgeHashCache()
 	// being about 600 texture uploads per frame. We'll use 800 as an upper bound for a bit of
 	// a buffer, hopefully nothing's going to end up with more textures than that.
 	constexpr u32 MAX_HASH_CACHE_SIZE = 800;
-	constexpr u32 MAX_HASH_CACHE_AGE = 30;
 
 	bool might_need_cache_purge = (m_hash_cache.size() > MAX_HASH_CACHE_SIZE);
 	if (might_need_cache_purge)
@@ -7211,6 +7284,113 @@ void GSTextureCache::AgeHashCache()
 		for (u32 i = 0; i < entries_to_purge; i++)
 			RemoveFromHashCache(s_hash_cache_purge_list[i].first);
 	}
+
+	// Forget hashes of textures which haven't been looked up in a while.
+	for (auto it = m_async_hashes.begin(); it != m_async_hashes.end();)
+	{
+		AsyncHashJob& job = *it->second;
+		if (job.done.load(std::memory_order_acquire) && ++job.age > MAX_HASH_CACHE_AGE)
+			it = m_async_hashes.erase(it);
+		else
+			++it;
+	}
+}
+
+bool GSTextureCache::LookupAsyncHash(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, SourceRegion region, HashType* hash)
+{
+	const GSLocalMemory::psm_t& psm = GSLocalMemory::m_psm[TEX0.PSM];
+	const AsyncHashKey key = {TEX0.U64 & 0x00000003FFFFFFFFULL,
+		(psm.pal == 0 && psm.fmt > 0) ? (TEXA.U64 & 0x000000FF000080FFULL) : 0, region.bits};
+
+	const auto it = m_async_hashes.find(key);
+	if (it != m_async_hashes.end())
+	{
+		AsyncHashJob& job = *it->second;
+		if (!job.done.load(std::memory_order_acquire))
+		{
+			GL_CACHE("TC: Async hash pending for 0x%x, uploading directly", TEX0.TBP0);
+			return false;
+		}
+
+		// Still valid if nothing has written to the texture since it was submitted.
+		// This also saves rehashing unchanged textures when they're looked up again.
+		if (job.generation == GetPageWriteGeneration(job.pages))
+		{
+			job.age = 0;
+			*hash = job.hash;
+			return true;
+		}
+
+		m_async_hashes.erase(it);
+	}
+
+	SubmitAsyncHash(key, TEX0, TEXA, region);
+	return false;
+}
+
+void GSTextureCache::SubmitAsyncHash(const AsyncHashKey& key, const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, SourceRegion region)
+{
+	// Don't let the GS thread wait on a full queue, that defeats the point.
+	if (m_async_hashes_in_flight.load(std::memory_order_relaxed) >= ASYNC_HASH_MAX_IN_FLIGHT)
+		return;
+
+	if (m_async_hash_workers.empty())
+	{
+		for (u32 i = 0; i < NUM_ASYNC_HASH_WORKERS; i++)
+		{
+			m_async_hash_workers.push_back(std::make_unique<AsyncHashWorker>(
+				[i]() {
+					Threading::SetNameOfCurrentThread(TinyString::from_format("GS-AsyncHash-{}", i));
+					s_async_hash_buffer = static_cast<u8*>(_aligned_malloc(9 * _1mb, VECTOR_ALIGNMENT));
+					pxAssertRel(s_async_hash_buffer, "Failed to allocate async hash buffer");
+				},
+				[this](std::shared_ptr<AsyncHashJob>& job) {
+					job->hash = HashTexture(job->TEX0, job->TEXA, job->region, s_async_hash_buffer);
+					job->done.store(true, std::memory_order_release);
+					m_async_hashes_in_flight.fetch_sub(1, std::memory_order_relaxed);
+				},
+				[]() {
+					_aligned_free(s_async_hash_buffer);
+					s_async_hash_buffer = nullptr;
+				}));
+		}
+	}
+
+	const int tw = region.HasX() ? region.GetWidth() : (1 << TEX0.TW);
+	const int th = region.HasY() ? region.GetHeight() : (1 << TEX0.TH);
+	const GSOffset off = g_gs_renderer->m_mem.GetOffset(TEX0.TBP0, TEX0.TBW, TEX0.PSM);
+
+	std::shared_ptr<AsyncHashJob> job = std::make_shared<AsyncHashJob>();
+	job->TEX0 = TEX0;
+	job->TEXA = TEXA;
+	job->region = region;
+	job->pages = off.pageLooperForRect(region.GetRect(tw, th).ralign<Align_Outside>(GSLocalMemory::m_psm[TEX0.PSM].bs));
+	job->generation = GetPageWriteGeneration(job->pages);
+	job->hash = 0;
+	job->age = 0;
+	job->done.store(false, std::memory_order_relaxed);
+	m_async_hashes.emplace(key, job);
+
+	GL_CACHE("TC: Submitting async hash for 0x%x %s %dx%d", TEX0.TBP0, GSUtil::GetPSMName(TEX0.PSM), tw, th);
+	m_async_hashes_in_flight.fetch_add(1, std::memory_order_relaxed);
+	m_async_hash_workers[m_next_async_hash_worker]->Push(std::move(job));
+	m_next_async_hash_worker = (m_next_async_hash_worker + 1) % NUM_ASYNC_HASH_WORKERS;
+}
+
+void GSTextureCache::MarkPagesWritten(const GSOffset& off, const GSVector4i& rect)
+{
+	if (m_async_hashes.empty() || rect.rempty())
+		return;
+
+	off.pageLooperForRect(rect).loopPages([this](u32 page) { m_page_write_generation[page]++; });
+}
+
+u64 GSTextureCache::GetPageWriteGeneration(const GSOffset::PageLooper& pages) const
+{
+	// Generations only go up, so the sum changes if any page was written.
+	u64 generation = 0;
+	pages.loopPages([this, &generation](u32 page) { generation += m_page_write_generation[page]; });
+	return generation;
 }
 
 GSTextureCache::Target* GSTextureCache::Target::Create(GIFRegTEX0 TEX0, int w, int h, float scale, int type, bool clear)
@@ -7334,6 +7514,7 @@ void GSTextureCache::Read(Target* t, const GSVector4i& r)
 		return;
 
 	const GIFRegTEX0& TEX0 = t->m_TEX0;
+	MarkPagesWritten(g_gs_renderer->m_mem.GetOffset(TEX0.TBP0, TEX0.TBW, TEX0.PSM), r);
 	const bool is_depth = (t->m_type == DepthStencil);
 
 	GSTexture::Format fmt;
@@ -7458,6 +7639,8 @@ void GSTextureCache::Read(Source* t, const GSVector4i& r)
 	if (r.rempty())
 		return;
 
+	MarkPagesWritten(g_gs_renderer->m_mem.GetOffset(t->m_TEX0.TBP0, t->m_TEX0.TBW, t->m_TEX0.PSM), r);
+
 	const GSVector4i drc(0, 0, r.width(), r.height());
 
 	if (!PrepareDownloadTexture(drc.z, drc.w, GSTexture::Format::Color, &m_color_download_texture))
@@ -8301,9 +8484,15 @@ void GSTextureCache::SourceMap::Add(Source* s, const GIFRegTEX0& TEX0)
 	m_surfaces.insert(s);
 
 	// The source pointer will be stored/duplicated in all m_map[array of pages]
+	s->m_page_bits.reset();
 	s->m_pages.loopPages([this, s](u32 page) {
 		s->m_erase_it[page] = m_map[page].InsertFront(s);
+		s->m_page_bits.set(page);
 	});
+
+	s->m_lookup_key = GetLookupKey(s->m_TEX0);
+	std::vector<Source*>& sources = m_lookup[s->m_lookup_key];
+	sources.insert(sources.begin(), s);
 }
 
 void GSTextureCache::SourceMap::SwapTexture(GSTexture* old_tex, GSTexture* new_tex)
@@ -8330,6 +8519,7 @@ void GSTextureCache::SourceMap::RemoveAll()
 	}
 
 	m_surfaces.clear();
+	m_lookup.clear();
 
 	for (FastList<Source*>& item : m_map)
 	{
@@ -8348,6 +8538,14 @@ void GSTextureCache::SourceMap::RemoveAt(Source* s)
 		m_map[page].EraseIndex(s->m_erase_it[page]);
 	});
 
+	if (const auto bucket = m_lookup.find(s->m_lookup_key); bucket != m_lookup.end())
+	{
+		std::vector<Source*>& sources = bucket->second;
+		sources.erase(std::find(sources.begin(), sources.end(), s));
+		if (sources.empty())
+			m_lookup.erase(bucket);
+	}
+
 	if (s->m_from_hash_cache)
 	{
 		pxAssert(s->m_from_hash_cache->refcount > 0);
@@ -9066,11 +9264,11 @@ static void HashTextureLevel(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, GST
 	}
 }
 
-GSTextureCache::HashType GSTextureCache::HashTexture(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, SourceRegion region)
+GSTextureCache::HashType GSTextureCache::HashTexture(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, SourceRegion region, u8* temp)
 {
 	BlockHashState hash_st;
 	BlockHashReset(hash_st);
-	HashTextureLevel(TEX0, TEXA, region, hash_st, s_unswizzle_buffer);
+	HashTextureLevel(TEX0, TEXA, region, hash_st, temp ? temp : s_unswizzle_buffer);
 	return FinishBlockHash(hash_st);
 }
 
@@ -9137,15 +9335,6 @@ GSTextureCache::HashCacheKey::HashCacheKey()
 
 GSTextureCache::HashCacheKey GSTextureCache::HashCacheKey::Create(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, const u32* clut, const GSVector2i* lod, SourceRegion region)
 {
-	const GSLocalMemory::psm_t& psm = GSLocalMemory::m_psm[TEX0.PSM];
-
-	HashCacheKey ret;
-	ret.TEX0.U64 = TEX0.U64 & 0x00000003FFF00000ULL; // PSM, TW, TH
-	ret.TEXA.U64 = (psm.pal == 0 && psm.fmt > 0) ? (TEXA.U64 & 0x000000FF000080FFULL) : 0;
-	ret.CLUTHash = clut ? GSTextureCache::PaletteKeyHash{}({clut, psm.pal}) : 0;
-	ret.region_width = static_cast<u16>(region.GetWidth());
-	ret.region_height = static_cast<u16>(region.GetHeight());
-
 	BlockHashState hash_st;
 	BlockHashReset(hash_st);
 
@@ -9164,8 +9353,20 @@ GSTextureCache::HashCacheKey GSTextureCache::HashCacheKey::Create(const GIFRegTE
 		}
 	}
 
-	ret.TEX0Hash = FinishBlockHash(hash_st);
+	return Create(TEX0, TEXA, clut, region, FinishBlockHash(hash_st));
+}
 
+GSTextureCache::HashCacheKey GSTextureCache::HashCacheKey::Create(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, const u32* clut, SourceRegion region, HashType tex0_hash)
+{
+	const GSLocalMemory::psm_t& psm = GSLocalMemory::m_psm[TEX0.PSM];
+
+	HashCacheKey ret;
+	ret.TEX0.U64 = TEX0.U64 & 0x00000003FFF00000ULL; // PSM, TW, TH
+	ret.TEXA.U64 = (psm.pal == 0 && psm.fmt > 0) ? (TEXA.U64 & 0x000000FF000080FFULL) : 0;
+	ret.CLUTHash = clut ? GSTextureCache::PaletteKeyHash{}({clut, psm.pal}) : 0;
+	ret.region_width = static_cast<u16>(region.GetWidth());
+	ret.region_height = static_cast<u16>(region.GetHeight());
+	ret.TEX0Hash = tex0_hash;
 	return ret;
 }
 
@@ -9181,6 +9382,13 @@ void GSTextureCache::HashCacheKey::RemoveCLUTHash()
 	CLUTHash = 0;
 }
 
+u64 GSTextureCache::AsyncHashKeyHash::operator()(const AsyncHashKey& key) const
+{
+	std::size_t h = 0;
+	HashCombine(h, key.TEX0, key.TEXA, key.region);
+	return h;
+}
+
 u64 GSTextureCache::HashCacheKeyHash::operator()(const HashCacheKey& key) const
 {
 	std::size_t h = 0;
@@ -6,7 +6,10 @@
 #include "GS/Renderers/Common/GSRenderer.h"
 #include "GS/Renderers/Common/GSFastList.h"
 #include "GS/Renderers/Common/GSDirtyRect.h"
+#include "GS/GSJobQueue.h"
 
+#include <atomic>
+#include <bitset>
 #include <unordered_set>
 #include <utility>
 #include <limits>
@@ -110,6 +113,7 @@ public:
 		HashCacheKey();
 
 		static HashCacheKey Create(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, const u32* clut, const GSVector2i* lod, SourceRegion region);
+		static HashCacheKey Create(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, const u32* clut, SourceRegion region, HashType tex0_hash);
 
 		HashCacheKey WithRemovedCLUTHash() const;
 		void RemoveCLUTHash();
@@ -137,6 +141,37 @@ public:
 
 	using HashCacheMap = std::unordered_map<HashCacheKey, HashCacheEntry, HashCacheKeyHash>;
 
+	/// Texture data hashed on a worker thread. The result is only trusted if none of
+	/// the pages it covers have been written since the job was submitted.
+	struct AsyncHashKey
+	{
+		u64 TEX0; // TBP0, TBW, PSM, TW, TH
+		u64 TEXA;
+		u64 region;
+
+		__fi bool operator==(const AsyncHashKey& e) const { return std::memcmp(this, &e, sizeof(*this)) == 0; }
+	};
+
+	struct AsyncHashKeyHash
+	{
+		u64 operator()(const AsyncHashKey& key) const;
+	};
+
+	struct AsyncHashJob
+	{
+		GIFRegTEX0 TEX0;
+		GIFRegTEXA TEXA;
+		SourceRegion region;
+		GSOffset::PageLooper pages;
+		u64 generation;
+		HashType hash;
+		u16 age;
+		std::atomic_bool done;
+	};
+
+	using AsyncHashMap = std::unordered_map<AsyncHashKey, std::shared_ptr<AsyncHashJob>, AsyncHashKeyHash>;
+	using AsyncHashWorker = GSJobQueue<std::shared_ptr<AsyncHashJob>, 256>;
+
 	class Surface : public GSAlignedClass<32>
 	{
 	protected:
@@ -328,6 +363,8 @@ public:
 		// Keep a GSTextureCache::SourceMap::m_map iterator to allow fast erase
 		// Deliberately not initialized to save cycles.
 		std::array<u16, GS_MAX_PAGES> m_erase_it;
+		std::bitset<GS_MAX_PAGES> m_page_bits; // pages this source is in m_map for
+		u64 m_lookup_key = 0; // key in GSTextureCache::SourceMap::m_lookup
 		GSOffset::PageLooper m_pages;
 
 	public:
@@ -377,7 +414,23 @@ public:
 		std::unordered_set<Source*> m_surfaces;
 		std::array<FastList<Source*>, GS_MAX_PAGES> m_map;
 
+		// Secondary index on the TEX0 fields every lookup must match exactly (TBP0, TBW, PSM, TW, TH),
+		// most recently used first. Resolves most lookups without walking every source on the page.
+		std::unordered_map<u64, std::vector<Source*>> m_lookup;
+
+		__fi static u64 GetLookupKey(const GIFRegTEX0& TEX0)
+		{
+			return TEX0.U32[0] | (static_cast<u64>(TEX0.U32[1] & 3) << 32);
+		}
+
 		void Add(Source* s, const GIFRegTEX0& TEX0);
+
+		/// Finds a source on the given page which can be used for TEX0, moving it to the front of the page list.
+		/// When several sources match, the one nearest the front of the page list wins.
+		Source* Lookup(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, const GSLocalMemory::psm_t& psm_s,
+			const u32* clut, const GSTexture* gpu_clut, const GSVector2i& compare_lod, const SourceRegion& region,
+			u32 fixed_tex0, u32 page, const GIFRegCLAMP& CLAMP, const GSVector4i& read_area);
+
 		void SwapTexture(GSTexture* old_tex, GSTexture* new_tex);
 		void RemoveAll();
 		void RemoveAt(Source* s);
@@ -436,7 +489,17 @@ protected:
 	PaletteMap m_palette_map;
 	SourceMap m_src;
 	u64 m_source_memory_usage = 0;
+	constexpr static u32 MAX_HASH_CACHE_AGE = 30;
+	constexpr static u32 ASYNC_HASH_MIN_TEXTURE_SIZE = 512 * 1024; // bytes of texture data
+	constexpr static u32 ASYNC_HASH_MAX_IN_FLIGHT = 64;
+	constexpr static u32 NUM_ASYNC_HASH_WORKERS = 2;
+
 	HashCacheMap m_hash_cache;
+	AsyncHashMap m_async_hashes;
+	std::vector<std::unique_ptr<AsyncHashWorker>> m_async_hash_workers;
+	std::atomic<u32> m_async_hashes_in_flight{0};
+	u32 m_next_async_hash_worker = 0;
+	std::array<u32, GS_MAX_PAGES> m_page_write_generation = {};
 	u64 m_hash_cache_memory_usage = 0;
 	u64 m_hash_cache_replacement_memory_usage = 0;
 
@@ -479,8 +542,15 @@ protected:
 	HashCacheMap::iterator RemoveFromHashCache(HashCacheMap::iterator it);
 	void AgeHashCache();
 
+	/// Large textures are hashed off the GS thread. Returns false if the hash isn't available yet,
+	/// in which case the texture should be uploaded directly instead of through the hash cache.
+	bool LookupAsyncHash(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, SourceRegion region, HashType* hash);
+	void SubmitAsyncHash(const AsyncHashKey& key, const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, SourceRegion region);
+	void MarkPagesWritten(const GSOffset& off, const GSVector4i& rect);
+	u64 GetPageWriteGeneration(const GSOffset::PageLooper& pages) const;
+
 	static void PreloadTexture(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, SourceRegion region, GSLocalMemory& mem, bool paltex, GSTexture* tex, u32 level, std::pair<u8, u8>* alpha_minmax);
-	static HashType HashTexture(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, SourceRegion region);
+	static HashType HashTexture(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, SourceRegion region, u8* temp = nullptr);
 
 	// TODO: virtual void Write(Source* s, const GSVector4i& r) = 0;
 	// TODO: virtual void Write(Target* t, const GSVector4i& r) = 0;
@@ -6,8 +6,15 @@
 #include "GS/Renderers/SW/GSScanlineEnvironment.h"
 #include "GS/Renderers/SW/GSRasterizer.h"
 
+#include "Config.h"
+
 #include "common/Console.h"
+#include "common/KeyProfile.h"
+#include "common/Path.h"
+
+#include "fmt/format.h"
 
+#include <cstring>
 #include <fstream>
 
 // Comment to disable all dynamic code generation.
@@ -35,6 +42,8 @@ GSDrawScanline::GSDrawScanline()
 
 GSDrawScanline::~GSDrawScanline()
 {
+	CloseProfile();
+
 	if (const size_t used = GSCodeReserve::GetMemoryUsed(); used > 0)
 		DevCon.WriteLn("SW JIT generated %zu bytes of code", used);
 }
@@ -126,6 +135,9 @@ bool GSDrawScanline::SetupDraw(GSRasterizerData& data)
 	const GSScanlineGlobalData& global = data.global;
 
 #ifdef ENABLE_JIT_RASTERIZER
+	if (!m_sp_pending.empty() || !m_ds_pending.empty()) [[unlikely]]
+		PregenerateProfile();
+
 	data.draw_scanline = m_ds_map[global.sel];
 	if (!data.draw_scanline) [[unlikely]]
 		return false;
@@ -174,6 +186,90 @@ bool GSDrawScanline::SetupDraw(GSRasterizerData& data)
 #endif
 }
 
+// --------------------------------------------------------------------------------------
+//  JIT Profiles
+// --------------------------------------------------------------------------------------
+// The selectors of every function generated for a game are saved to the cache directory,
+// and generated a few at a time ahead of their first draw the next time the game runs.
+
+static constexpr u32 SW_JIT_PROFILE_MAGIC = 0x504A5753; // SWJP
+static constexpr u32 SW_JIT_PROFILE_VERSION = 1;
+
+// Generating is done on the GS thread, which owns the code reserve, so spread it over draws.
+static constexpr u32 SW_JIT_PROFILE_KEYS_PER_DRAW = 8;
+
+void GSDrawScanline::OpenProfile(const std::string& serial, u32 crc)
+{
+	CloseProfile();
+
+	if (serial.empty())
+		return;
+
+	m_profile_path = Path::Combine(EmuFolders::Cache, Path::SanitizeFileName(fmt::format("swjit_{}_{:08X}.bin", serial, crc)));
+	if (!KeyProfile::Load(m_profile_path, SW_JIT_PROFILE_MAGIC, SW_JIT_PROFILE_VERSION, &m_sp_pending, &m_ds_pending))
+		return;
+
+	for (const u64 key : m_sp_pending)
+		m_sp_map.AddToProfile(key);
+	for (const u64 key : m_ds_pending)
+		m_ds_map.AddToProfile(key);
+
+	DevCon.WriteLn("Loaded SW JIT profile with %zu setup prim and %zu draw scanline functions", m_sp_pending.size(),
+		m_ds_pending.size());
+}
+
+void GSDrawScanline::CloseProfile()
+{
+	if (!m_profile_path.empty() && (m_sp_map.IsProfileDirty() || m_ds_map.IsProfileDirty()) &&
+		!KeyProfile::Save<u64>(m_profile_path, SW_JIT_PROFILE_MAGIC, SW_JIT_PROFILE_VERSION, m_sp_map.GetProfile(),
+			m_ds_map.GetProfile()))
+	{
+		Console.Error("Failed to write SW JIT profile '%s'", m_profile_path.c_str());
+	}
+
+	m_profile_path = {};
+	m_sp_pending = {};
+	m_ds_pending = {};
+	m_sp_map.ClearProfile();
+	m_ds_map.ClearProfile();
+}
+
+void GSDrawScanline::PregenerateProfile()
+{
+	// Leave at least half of the reserve for functions the profile didn't cover, so it doesn't cause a reset.
+	const size_t reserve_size = GSCodeReserve::GetMemoryUsed() + GSCodeReserve::GetMemoryAvailable();
+	if (GSCodeReserve::GetMemoryAvailable() < reserve_size / 2)
+	{
+		DevCon.WriteLn("SW JIT profile exceeds half the code reserve, skipping %zu functions",
+			m_sp_pending.size() + m_ds_pending.size());
+		m_sp_pending = {};
+		m_ds_pending = {};
+		return;
+	}
+
+	u32 count = 0;
+	while (!m_ds_pending.empty() && count < SW_JIT_PROFILE_KEYS_PER_DRAW)
+	{
+		const u64 key = m_ds_pending.back();
+		m_ds_pending.pop_back();
+		if (!m_ds_map.IsGenerated(key))
+		{
+			m_ds_map.GetDefaultFunction(key);
+			count++;
+		}
+	}
+	while (!m_sp_pending.empty() && count < SW_JIT_PROFILE_KEYS_PER_DRAW)
+	{
+		const u64 key = m_sp_pending.back();
+		m_sp_pending.pop_back();
+		if (!m_sp_map.IsGenerated(key))
+		{
+			m_sp_map.GetDefaultFunction(key);
+			count++;
+		}
+	}
+}
+
 void GSDrawScanline::UpdateDrawStats(u64 frame, u64 ticks, int actual, int total, int prims)
 {
 	m_ds_map.UpdateStats(frame, ticks, actual, total, prims);
@@ -42,6 +42,12 @@ public:
 	/// Populates function pointers. If this returns false, we ran out of code space.
 	bool SetupDraw(GSRasterizerData& data);
 
+	/// Loads the selectors generated the last time this game ran, so they can be generated before they're drawn with.
+	void OpenProfile(const std::string& serial, u32 crc);
+
+	/// Saves the selectors generated for the current game, if any are new.
+	void CloseProfile();
+
 	/// Draw pre-calculations, computed per-thread.
 	static void BeginDraw(const GSRasterizerData& data, GSScanlineLocalData& local);
 
@@ -55,6 +61,12 @@ private:
 	GSCodeGeneratorFunctionMap<GSSetupPrimCodeGenerator, u64, SetupPrimPtr> m_sp_map;
 	GSCodeGeneratorFunctionMap<GSDrawScanlineCodeGenerator, u64, DrawScanlinePtr> m_ds_map;
 
+	std::string m_profile_path;
+	std::vector<u64> m_sp_pending;
+	std::vector<u64> m_ds_pending;
+
+	void PregenerateProfile();
+
 	static void CSetupPrim(const GSVertexSW* vertex, const u16* index, const GSVertexSW& dscan, GSScanlineLocalData& local);
 	static void CDrawScanline(int pixels, int left, int top, const GSVertexSW& scan, GSScanlineLocalData& local);
 	static void CDrawEdge(int pixels, int left, int top, const GSVertexSW& scan, GSScanlineLocalData& local);
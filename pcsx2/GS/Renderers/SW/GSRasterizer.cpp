@@ -49,13 +49,21 @@ GSRasterizer::GSRasterizer(GSDrawScanline* ds, int id, int threads)
 	if (!m_edge.buff)
 		pxFailRel("failed to allocate storage for m_edge.buff");
 
-	int rows = (2048 >> m_thread_height) + 16;
+	const int bands = 2048 >> m_thread_height;
+	const int rows = bands + 16;
 	m_scanline = (u8*)_aligned_malloc(rows, 64);
 
-	for (int i = 0; i < rows; i++)
+	for (int i = 0; i < bands; i++)
 	{
 		m_scanline[i] = (i % threads) == id ? 1 : 0;
 	}
+
+	// Rows past the end of the screen belong to everyone, so FindMyNextScanline() always terminates,
+	// regardless of how the bands have been distributed between the threads.
+	for (int i = bands; i < rows; i++)
+	{
+		m_scanline[i] = 1;
+	}
 }
 
 GSRasterizer::~GSRasterizer()
@@ -111,6 +119,16 @@ int GSRasterizer::FindMyNextScanline(int top) const
 	return top;
 }
 
+void GSRasterizer::SetBandOwners(const u8* owners)
+{
+	const int bands = 2048 >> m_thread_height;
+
+	for (int i = 0; i < bands; i++)
+	{
+		m_scanline[i] = (owners[i] == m_id) ? 1 : 0;
+	}
+}
+
 int GSRasterizer::GetPixels(bool reset)
 {
 	int pixels = m_pixels.sum;
@@ -128,6 +146,8 @@ void GSRasterizer::Draw(GSRasterizerData& data)
 	if ((data.vertex && data.vertex_count == 0) || (data.index && data.index_count == 0))
 		return;
 
+	data.PrepareDraw();
+
 	m_pixels.actual = 0;
 	m_pixels.total = 0;
 	m_primcount = 0;
@@ -875,7 +895,7 @@ void GSRasterizer::DrawTriangleSection(int top, int bottom, GSVertexSW2& RESTRIC
 
 		if (!IsOneOfMyScanlines(top))
 		{
-			top += (m_threads - 1) << m_thread_height;
+			top = FindMyNextScanline(top);
 		}
 	}
 
@@ -1076,7 +1096,7 @@ void GSRasterizer::DrawTriangleSection(int top, int bottom, GSVertexSW& RESTRICT
 
 		if (!IsOneOfMyScanlines(top))
 		{
-			top += (m_threads - 1) << m_thread_height;
+			top = FindMyNextScanline(top);
 		}
 	}
 
@@ -1140,7 +1160,7 @@ void GSRasterizer::DrawSprite(const GSVertexSW* vertex, const u16* index)
 				m_pixels.actual += pixels;
 				m_pixels.total += pixels;
 
-				top = r.bottom + ((m_threads - 1) << m_thread_height);
+				top = FindMyNextScanline(r.bottom);
 			}
 		}
 
@@ -1498,13 +1518,19 @@ void GSSingleRasterizer::PrintStats()
 #endif
 }
 
+void GSSingleRasterizer::OpenScanlineProfile(const std::string& serial, u32 crc)
+{
+	m_ds.OpenProfile(serial, crc);
+}
+
 //
 
 GSRasterizerList::GSRasterizerList(int threads)
 {
 	m_thread_height = compute_best_thread_height(threads);
+	m_bands = 2048 >> m_thread_height;
 
-	const int rows = (2048 >> m_thread_height) + 16;
+	const int rows = m_bands + 16;
 	m_scanline = static_cast<u8*>(_aligned_malloc(rows, 64));
 
 	for (int i = 0; i < rows; i++)
@@ -1512,6 +1538,8 @@ GSRasterizerList::GSRasterizerList(int threads)
 		m_scanline[i] = static_cast<u8>(i % threads);
 	}
 
+	m_band_load.resize(m_bands);
+
 	PerformanceMetrics::SetGSSWThreadCount(threads);
 }
 
@@ -1552,12 +1580,24 @@ void GSRasterizerList::Queue(const GSRingHeap::SharedPtr<GSRasterizerData>& data
 
 	pxAssert(r.top >= 0 && r.top <= 2048 && r.bottom >= 0 && r.bottom <= 2048);
 
-	int top = r.top >> m_thread_height;
-	int bottom = std::min<int>((r.bottom + (1 << m_thread_height) - 1) >> m_thread_height, top + (int)m_workers.size());
+	const int top = r.top >> m_thread_height;
+	const int bottom = (r.bottom + (1 << m_thread_height) - 1) >> m_thread_height;
+	const int width = r.width();
+	u64 threads = 0;
 
-	while (top < bottom)
+	for (int i = top; i < bottom; i++)
 	{
-		m_workers[m_scanline[top++]]->Push(data);
+		// Estimate the work in each band from the bounding box, it's only used to balance the bands.
+		const int band_top = std::max(r.top, i << m_thread_height);
+		const int band_bottom = std::min(r.bottom, (i + 1) << m_thread_height);
+		m_band_load[i] += static_cast<u64>(width * (band_bottom - band_top));
+
+		const int owner = m_scanline[i];
+		if (!(threads & (static_cast<u64>(1) << owner)))
+		{
+			threads |= static_cast<u64>(1) << owner;
+			m_workers[owner]->Push(data);
+		}
 	}
 }
 
@@ -1572,6 +1612,70 @@ void GSRasterizerList::Sync()
 
 		g_perfmon.Put(GSPerfMon::SyncPoint, 1);
 	}
+
+	// All the workers are idle, so we can safely move bands between them.
+	const int frame = g_perfmon.GetFrame();
+	if (frame != m_balance_frame)
+	{
+		m_balance_frame = frame;
+		RebalanceBands();
+	}
+}
+
+void GSRasterizerList::RebalanceBands()
+{
+	// Each band has to stay owned by a single thread between sync points, otherwise draws could be
+	// rasterized out of order. But at a sync point, we're free to reassign them. Rather than a
+	// static interleave, which leaves threads idle when the work is concentrated in a few rows
+	// (HUDs, letterboxing), hand the heaviest bands out first to whichever thread has the least work.
+	const int threads = static_cast<int>(m_workers.size());
+
+	std::vector<u64> current(threads);
+	u64 total = 0;
+	for (int i = 0; i < m_bands; i++)
+	{
+		current[m_scanline[i]] += m_band_load[i];
+		total += m_band_load[i];
+	}
+
+	// Don't shuffle things around if the current distribution is good enough, moving bands
+	// between threads costs us cache locality.
+	const u64 worst = *std::max_element(current.begin(), current.end());
+	if (total == 0 || worst * threads <= total + (total / 4))
+	{
+		for (u64& load : m_band_load)
+			load /= 2;
+		return;
+	}
+
+	std::vector<u16> order(m_bands);
+	for (int i = 0; i < m_bands; i++)
+		order[i] = static_cast<u16>(i);
+
+	std::stable_sort(order.begin(), order.end(),
+		[this](u16 lhs, u16 rhs) { return m_band_load[lhs] > m_band_load[rhs]; });
+
+	std::vector<u64> assigned(threads);
+	for (const u16 band : order)
+	{
+		if (m_band_load[band] == 0)
+		{
+			// Nothing was drawn here, so fall back to the usual interleave.
+			m_scanline[band] = static_cast<u8>(band % threads);
+			continue;
+		}
+
+		const int owner = static_cast<int>(std::min_element(assigned.begin(), assigned.end()) - assigned.begin());
+		assigned[owner] += m_band_load[band];
+		m_scanline[band] = static_cast<u8>(owner);
+	}
+
+	for (const std::unique_ptr<GSRasterizer>& r : m_r)
+		r->SetBandOwners(m_scanline);
+
+	// Decay the history, so we follow the scene as it changes.
+	for (u64& load : m_band_load)
+		load /= 2;
 }
 
 bool GSRasterizerList::IsSynced() const
@@ -1601,7 +1705,8 @@ int GSRasterizerList::GetPixels(bool reset)
 
 std::unique_ptr<IRasterizer> GSRasterizerList::Create(int threads)
 {
-	threads = std::max<int>(threads, 0);
+	// Band ownership is tracked with a 64-bit mask when queueing.
+	threads = std::clamp<int>(threads, 0, 64);
 
 	if (threads == 0)
 	{
@@ -1633,6 +1738,12 @@ void GSRasterizerList::PrintStats()
 {
 }
 
+void GSRasterizerList::OpenScanlineProfile(const std::string& serial, u32 crc)
+{
+	// Workers only call functions which have already been generated, so they don't need to be idle.
+	m_ds.OpenProfile(serial, crc);
+}
+
 #define INIT4(x0, x1, x2, x3, x4) static_cast<DrawEdgeTrianglePtr>(&GSRasterizer::DrawEdgeTriangle<x0, x1, x2, x3, x4>)
 #define INIT3(x0, x1, x2, x3) { INIT4(x0, x1, x2, x3, false)    , INIT4(x0, x1, x2, x3, true) } 
 #define INIT2(x0, x1, x2)     { INIT3(x0, x1, x2, false)        , INIT3(x0, x1, x2, true)     } 
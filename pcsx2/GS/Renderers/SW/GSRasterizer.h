@@ -62,6 +62,9 @@ public:
 		if (buff != NULL)
 			GSRingHeap::free(buff);
 	}
+
+	/// Work which has to finish before any thread draws, run by every thread the draw is queued to.
+	virtual void PrepareDraw() {}
 };
 
 class alignas(32) GSRasterizer final : public GSVirtualAlignedClass<32>
@@ -132,6 +135,9 @@ public:
 	__forceinline bool IsOneOfMyScanlines(int top, int bottom) const;
 	__forceinline int FindMyNextScanline(int top) const;
 
+	/// Updates which bands of scanlines this rasterizer owns. Must only be called while idle.
+	void SetBandOwners(const u8* owners);
+
 	void Draw(GSRasterizerData& data);
 	int GetPixels(bool reset);
 };
@@ -146,6 +152,7 @@ public:
 	virtual bool IsSynced() const = 0;
 	virtual int GetPixels(bool reset = true) = 0;
 	virtual void PrintStats() = 0;
+	virtual void OpenScanlineProfile(const std::string& serial, u32 crc) = 0;
 };
 
 class GSSingleRasterizer final : public IRasterizer
@@ -159,6 +166,7 @@ public:
 	bool IsSynced() const override;
 	int GetPixels(bool reset = true) override;
 	void PrintStats() override;
+	void OpenScanlineProfile(const std::string& serial, u32 crc) override;
 
 	void Draw(GSRasterizerData& data);
 
@@ -179,9 +187,16 @@ protected:
 	std::vector<std::unique_ptr<GSWorker>> m_workers;
 	u8* m_scanline;
 	int m_thread_height;
+	int m_bands;
+	int m_balance_frame = -1;
+
+	// Estimated pixels drawn in each band since the last rebalance.
+	std::vector<u64> m_band_load;
 
 	GSRasterizerList(int threads);
 
+	void RebalanceBands();
+
 	static void OnWorkerStartup(int i, u64 affinity);
 	static void OnWorkerShutdown(int i);
 
@@ -197,6 +212,7 @@ public:
 	bool IsSynced() const override;
 	int GetPixels(bool reset) override;
 	void PrintStats() override;
+	void OpenScanlineProfile(const std::string& serial, u32 crc) override;
 };
 
 MULTI_ISA_UNSHARED_END
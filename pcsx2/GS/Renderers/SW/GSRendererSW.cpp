@@ -5,6 +5,7 @@
 #include "GS/GSGL.h"
 #include "GS/GSPng.h"
 #include "GS/GSUtil.h"
+#include "VMManager.h"
 
 #include "common/StringUtil.h"
 
@@ -28,6 +29,8 @@ GSRendererSW::GSRendererSW(int threads)
 
 	m_tc = std::make_unique<GSTextureCacheSW>();
 	m_rl = GSRasterizerList::Create(threads);
+	m_threaded_unswizzle = (threads > 0);
+	m_rl->OpenScanlineProfile(VMManager::GetDiscSerial(), VMManager::GetDiscCRC());
 
 	m_output = (u8*)_aligned_malloc(1024 * 1024 * sizeof(u32), VECTOR_ALIGNMENT);
 
@@ -43,6 +46,11 @@ GSRendererSW::~GSRendererSW()
 	GSRendererSW::Destroy();
 }
 
+void GSRendererSW::GameChanged()
+{
+	m_rl->OpenScanlineProfile(VMManager::GetDiscSerial(), VMManager::GetDiscCRC());
+}
+
 void GSRendererSW::Reset(bool hardware_reset)
 {
 	Sync(-1);
@@ -655,7 +663,7 @@ void GSRendererSW::Queue(GSRingHeap::SharedPtr<GSRasterizerData>& item)
 
 	// update previously invalidated parts
 
-	sd->UpdateSource();
+	sd->UpdateSource(m_threaded_unswizzle);
 
 	if (sd->m_syncpoint == SharedData::SyncTarget)
 	{
@@ -1653,13 +1661,22 @@ void GSRendererSW::SharedData::SetSource(GSTextureCacheSW::Texture* t, const GSV
 	m_tex[level + 1].t = nullptr;
 }
 
-void GSRendererSW::SharedData::UpdateSource()
+void GSRendererSW::SharedData::PrepareDraw()
+{
+	for (const std::shared_ptr<GSTextureCacheSW::DecodeJob>& job : m_decode_jobs)
+		job->Run();
+}
+
+void GSRendererSW::SharedData::UpdateSource(bool threaded)
 {
 	for (size_t i = 0; m_tex[i].t; i++)
 	{
-		if (m_tex[i].t->Update(m_tex[i].r))
+		if (m_tex[i].t->Update(m_tex[i].r, threaded))
 		{
 			global.tex[i] = m_tex[i].t->m_buff;
+
+			// Including jobs from earlier draws, which might not have been run by the threads this draw goes to.
+			m_decode_jobs.insert(m_decode_jobs.end(), m_tex[i].t->m_decode_jobs.begin(), m_tex[i].t->m_decode_jobs.end());
 		}
 		else
 		{
@@ -1673,6 +1690,9 @@ void GSRendererSW::SharedData::UpdateSource()
 	{
 		const u64 frame = g_perfmon.GetFrame();
 
+		// The dump needs the texture now, not when it's drawn.
+		PrepareDraw();
+
 		std::string s;
 
 		for (u32 i = 0; m_tex[i].t; i++)
@@ -28,6 +28,7 @@ public:
 		int m_zpsm;
 		bool m_using_pages;
 		TextureLevel m_tex[7 + 1]; // NULL terminated
+		std::vector<std::shared_ptr<GSTextureCacheSW::DecodeJob>> m_decode_jobs;
 		enum
 		{
 			SyncNone,
@@ -43,7 +44,9 @@ public:
 		void ReleasePages();
 
 		void SetSource(GSTextureCacheSW::Texture* t, const GSVector4i& r, int level);
-		void UpdateSource();
+		void UpdateSource(bool threaded);
+
+		void PrepareDraw() override;
 	};
 
 protected:
@@ -59,8 +62,10 @@ protected:
 	std::atomic<u16> m_tex_pages[512];
 	GIFRegDIMX m_last_dimx = {};
 	GSVector4i m_dimx[8] = {};
+	bool m_threaded_unswizzle = false; // large texture updates are split between the rasterizer threads
 
 	void Reset(bool hardware_reset) override;
+	void GameChanged() override;
 	void VSync(u32 field, bool registers_written, bool idle_frame) override;
 	GSTexture* GetOutput(int i, float& scale, int& y_offset) override;
 	GSTexture* GetFeedbackOutput(float& scale) override;
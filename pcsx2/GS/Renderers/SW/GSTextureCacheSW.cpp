@@ -7,6 +7,14 @@
 #include "GS/GSPng.h"
 #include "GS/GSUtil.h"
 
+#include "common/Threading.h"
+
+// Updates smaller than this are unswizzled on the GS thread, it's not worth waking the other threads.
+static constexpr u32 DECODE_JOB_MIN_BLOCKS = 256;
+
+// Blocks claimed by a thread at a time, small enough to balance, large enough to not contend.
+static constexpr u32 DECODE_JOB_BATCH_BLOCKS = 16;
+
 GSTextureCacheSW::GSTextureCacheSW() = default;
 
 GSTextureCacheSW::~GSTextureCacheSW()
@@ -125,6 +133,37 @@ void GSTextureCacheSW::IncAge()
 
 //
 
+GSTextureCacheSW::DecodeJob::DecodeJob(u8* buff, u32 pitch, GSLocalMemory::readTextureBlock rtxbP, const GIFRegTEXA& TEXA)
+	: m_buff(buff)
+	, m_pitch(pitch)
+	, m_rtxbP(rtxbP)
+	, m_TEXA(TEXA)
+{
+}
+
+void GSTextureCacheSW::DecodeJob::Run()
+{
+	const GSLocalMemory& mem = g_gs_renderer->m_mem;
+	const u32 count = GetBlockCount();
+
+	for (;;)
+	{
+		const u32 start = m_next.fetch_add(DECODE_JOB_BATCH_BLOCKS, std::memory_order_relaxed);
+		if (start >= count)
+			break;
+
+		const u32 end = std::min(start + DECODE_JOB_BATCH_BLOCKS, count);
+		for (u32 i = start; i < end; i++)
+			m_rtxbP(mem, m_blocks[i].first, m_buff + m_blocks[i].second, m_pitch, m_TEXA);
+
+		m_done.fetch_add(end - start, std::memory_order_release);
+	}
+
+	// Everything's been claimed, but another thread might still be writing its batch.
+	while (!IsDone())
+		Threading::SpinWait();
+}
+
 GSTextureCacheSW::Texture::Texture(u32 tw0, const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA)
 	: m_TEX0(TEX0)
 	, m_TEXA(TEXA)
@@ -174,6 +213,7 @@ void GSTextureCacheSW::Texture::Reset(u32 tw0, const GIFRegTEX0& TEX0, const GIF
 	m_age = 0;
 	m_complete = false;
 	m_p2t = nullptr;
+	m_decode_jobs.clear();
 	m_TEX0 = TEX0;
 	m_TEXA = TEXA;
 
@@ -197,8 +237,11 @@ void GSTextureCacheSW::Texture::Reset(u32 tw0, const GIFRegTEX0& TEX0, const GIF
 	}
 }
 
-bool GSTextureCacheSW::Texture::Update(const GSVector4i& rect)
+bool GSTextureCacheSW::Texture::Update(const GSVector4i& rect, bool threaded)
 {
+	if (!m_decode_jobs.empty())
+		std::erase_if(m_decode_jobs, [](const std::shared_ptr<DecodeJob>& job) { return job->IsDone(); });
+
 	if (m_complete)
 	{
 		return true;
@@ -256,6 +299,11 @@ bool GSTextureCacheSW::Texture::Update(const GSVector4i& rect)
 
 	GSOffset::BNHelper bn = off.bnMulti(r.left, r.top);
 
+	// Only worth allocating a job if there could be enough blocks to split.
+	std::shared_ptr<DecodeJob> job;
+	if (threaded && static_cast<u32>((r.width() / bs.x) * (r.height() / bs.y)) >= DECODE_JOB_MIN_BLOCKS)
+		job = std::make_shared<DecodeJob>(static_cast<u8*>(m_buff), pitch, rtxbP, m_TEXA);
+
 	if (m_repeating)
 	{
 		for (; bn.blkY() < bottom; bn.nextBlockY(), dst += block_pitch)
@@ -272,7 +320,10 @@ bool GSTextureCacheSW::Texture::Update(const GSVector4i& rect)
 				{
 					m_valid[row] |= col;
 
-					rtxbP(mem, block, &dst[bn.blkX() << shift], pitch, m_TEXA);
+					if (job)
+						job->AddBlock(block, static_cast<u32>(&dst[bn.blkX() << shift] - static_cast<u8*>(m_buff)));
+					else
+						rtxbP(mem, block, &dst[bn.blkX() << shift], pitch, m_TEXA);
 
 					blocks++;
 				}
@@ -294,7 +345,10 @@ bool GSTextureCacheSW::Texture::Update(const GSVector4i& rect)
 				{
 					m_valid[row] |= col;
 
-					rtxbP(mem, block, &dst[bn.blkX() << shift], pitch, m_TEXA);
+					if (job)
+						job->AddBlock(block, static_cast<u32>(&dst[bn.blkX() << shift] - static_cast<u8*>(m_buff)));
+					else
+						rtxbP(mem, block, &dst[bn.blkX() << shift], pitch, m_TEXA);
 
 					blocks++;
 				}
@@ -302,6 +356,14 @@ bool GSTextureCacheSW::Texture::Update(const GSVector4i& rect)
 		}
 	}
 
+	if (job)
+	{
+		if (job->GetBlockCount() >= DECODE_JOB_MIN_BLOCKS)
+			m_decode_jobs.push_back(std::move(job));
+		else if (job->GetBlockCount() > 0)
+			job->Run();
+	}
+
 	if (blocks > 0)
 	{
 		g_perfmon.Put(GSPerfMon::Unswizzle, bs.x * bs.y * blocks << shift);
@@ -5,11 +5,41 @@
 
 #include "GS/Renderers/Common/GSRenderer.h"
 #include "GS/Renderers/Common/GSFastList.h"
+
+#include <atomic>
+#include <memory>
 #include <unordered_set>
+#include <vector>
 
 class GSTextureCacheSW
 {
 public:
+	/// Blocks of a texture waiting to be unswizzled, shared by every draw sampling from them, so the
+	/// rasterizer threads can split the work instead of the GS thread doing it all before queueing.
+	class DecodeJob
+	{
+	public:
+		DecodeJob(u8* buff, u32 pitch, GSLocalMemory::readTextureBlock rtxbP, const GIFRegTEXA& TEXA);
+
+		__fi u32 GetBlockCount() const { return static_cast<u32>(m_blocks.size()); }
+		__fi bool IsDone() const { return m_done.load(std::memory_order_acquire) == m_blocks.size(); }
+
+		/// Must only be called before the job is shared.
+		__fi void AddBlock(u32 block, u32 offset) { m_blocks.emplace_back(block, offset); }
+
+		/// Unswizzles blocks until there are none left, then waits for any other threads still working on them.
+		void Run();
+
+	private:
+		u8* m_buff;
+		u32 m_pitch;
+		GSLocalMemory::readTextureBlock m_rtxbP;
+		GIFRegTEXA m_TEXA;
+		std::vector<std::pair<u32, u32>> m_blocks; // block, offset into m_buff
+		std::atomic<u32> m_next{0};
+		std::atomic<u32> m_done{0};
+	};
+
 	class Texture
 	{
 	public:
@@ -27,6 +57,10 @@ public:
 		std::array<u16, GS_MAX_PAGES> m_erase_it;
 		const u32* RESTRICT m_sharedbits;
 
+		// Unswizzles which haven't finished yet. The blocks are already marked valid, so draws
+		// sampling from this texture have to run these first.
+		std::vector<std::shared_ptr<DecodeJob>> m_decode_jobs;
+
 		// m_valid
 		// fast mode: each u32 bits map to the 32 blocks of that page
 		// repeating mode: 1 bpp image of the texture tiles (8x8), also having 512 elements is just a coincidence (worst case: (1024*1024)/(8*8)/(sizeof(u32)*8))
@@ -36,7 +70,8 @@ public:
 
 		void Reset(u32 tw0, const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA);
 
-		bool Update(const GSVector4i& r);
+		/// When threaded, large updates are left in m_decode_jobs for the rasterizer threads to run.
+		bool Update(const GSVector4i& r, bool threaded = false);
 		bool Save(const std::string& fn) const;
 	};
 
@@ -37,8 +37,13 @@ static void GSDumpReplayerExitExecution();
 static void GSDumpReplayerCancelInstruction();
 static void GSDumpReplayerCpuClear(u32 addr, u32 size);
 
+// Packets are kept in memory a window of frames at a time, so large dumps don't need to fit in memory.
+static constexpr u64 PACKET_WINDOW_SIZE = 256 * _1mb;
+
 static std::unique_ptr<GSDumpFile> s_dump_file;
 static u32 s_current_packet = 0;
+static u32 s_next_window_frame = 0;
+static bool s_needs_window_loaded = false;
 static u32 s_dump_frame_number = 0;
 static s32 s_dump_loop_count = 0;
 static bool s_dump_running = false;
@@ -85,22 +90,48 @@ int GSDumpReplayer::GetLoopCount()
 	return s_dump_loop_count;
 }
 
+static bool GSDumpReplayerLoadWindow(GSDumpFile* file, u32 first_frame, Error* error)
+{
+	// Always take at least one frame, even if it's larger than the window.
+	const u32 frame_count = file->GetFrameCount();
+	const u64 start = file->GetFrameIndexEntry(first_frame).offset;
+	u32 num_frames = 1;
+	while ((first_frame + num_frames) < frame_count &&
+		   (file->GetFrameIndexEntry(first_frame + num_frames + 1).offset - start) <= PACKET_WINDOW_SIZE)
+	{
+		num_frames++;
+	}
+
+	return file->ReadFrames(first_frame, num_frames, error);
+}
+
+static std::unique_ptr<GSDumpFile> GSDumpReplayerOpenDump(const char* filename, Error* error)
+{
+	std::unique_ptr<GSDumpFile> dump = GSDumpFile::OpenGSDump(filename, error);
+	if (!dump || !dump->ReadHeaderAndIndex(filename, error) || !GSDumpReplayerLoadWindow(dump.get(), 0, error))
+		return {};
+
+	return dump;
+}
+
 bool GSDumpReplayer::Initialize(const char* filename, Error* error)
 {
 	Common::Timer timer;
 	Console.WriteLn("(GSDumpReplayer) Reading file '%s'...", filename);
 
 	Error dump_error;
-	s_dump_file = GSDumpFile::OpenGSDump(filename, &dump_error);
-	if (!s_dump_file || !s_dump_file->ReadFile(&dump_error))
+	s_dump_file = GSDumpReplayerOpenDump(filename, &dump_error);
+	if (!s_dump_file)
 	{
 		Error::SetStringFmt(error, TRANSLATE_FS("GSDumpReplayer", "Failed to open or read '{}': {}"),
 			Path::GetFileName(filename), dump_error.GetDescription());
-		s_dump_file.reset();
 		return false;
 	}
 
-	Console.WriteLn("(GSDumpReplayer) Read file in %.2f ms.", timer.GetTimeMilliseconds());
+	Console.WriteLn("(GSDumpReplayer) Read file in %.2f ms, %u frames, first %u loaded.", timer.GetTimeMilliseconds(),
+		s_dump_file->GetFrameCount(), s_dump_file->GetLoadedFrameCount());
+	s_current_packet = 0;
+	s_needs_window_loaded = false;
 
 	// We replace all CPUs.
 	Cpu = &GSDumpReplayerCpu;
@@ -125,8 +156,8 @@ bool GSDumpReplayer::ChangeDump(const char* filename)
 	}
 
 	Error error;
-	std::unique_ptr<GSDumpFile> new_dump(GSDumpFile::OpenGSDump(filename));
-	if (!new_dump || !new_dump->ReadFile(&error))
+	std::unique_ptr<GSDumpFile> new_dump = GSDumpReplayerOpenDump(filename, &error);
+	if (!new_dump)
 	{
 		Host::ReportErrorAsync("GSDumpReplayer", fmt::format("Failed to open or read '{}': {}",
 													 Path::GetFileName(filename), error.GetDescription()));
@@ -135,6 +166,7 @@ bool GSDumpReplayer::ChangeDump(const char* filename)
 
 	s_dump_file = std::move(new_dump);
 	s_current_packet = 0;
+	s_needs_window_loaded = false;
 
 	// Don't forget to reset the GS!
 	GSDumpReplayerCpuReset();
@@ -196,6 +228,10 @@ void GSDumpReplayerCpuReset()
 	s_needs_state_loaded = true;
 	s_current_packet = 0;
 	s_dump_frame_number = 0;
+
+	// Back to the start, if we've moved past the first window.
+	s_next_window_frame = 0;
+	s_needs_window_loaded = (s_dump_file && s_dump_file->GetFirstLoadedFrame() != 0);
 }
 
 static void GSDumpReplayerLoadInitialState()
@@ -264,10 +300,35 @@ void GSDumpReplayerCpuStep()
 		s_needs_state_loaded = false;
 	}
 
+	// Deferred from the end of the previous window, since the packet being processed pointed into it.
+	if (s_needs_window_loaded)
+	{
+		s_needs_window_loaded = false;
+
+		Error error;
+		if (!GSDumpReplayerLoadWindow(s_dump_file.get(), s_next_window_frame, &error))
+		{
+			Host::ReportErrorAsync("GSDumpReplayer", fmt::format("Failed to read frames from dump: {}", error.GetDescription()));
+			Host::RequestVMShutdown(false, false, false);
+			s_dump_running = false;
+			return;
+		}
+	}
+
 	const GSDumpFile::GSData& packet = s_dump_file->GetPackets()[s_current_packet];
 	s_current_packet = (s_current_packet + 1) % static_cast<u32>(s_dump_file->GetPackets().size());
-	if (s_current_packet == 0)
+
+	const u32 next_window_frame = s_dump_file->GetFirstLoadedFrame() + s_dump_file->GetLoadedFrameCount();
+	if (s_current_packet == 0 && next_window_frame < s_dump_file->GetFrameCount())
 	{
+		s_next_window_frame = next_window_frame;
+		s_needs_window_loaded = true;
+	}
+	else if (s_current_packet == 0)
+	{
+		s_next_window_frame = 0;
+		s_needs_window_loaded = (s_dump_file->GetFirstLoadedFrame() != 0);
+
 		s_dump_frame_number = 0;
 		if (s_dump_loop_count > 0)
 			s_dump_loop_count--;
@@ -399,7 +460,9 @@ void GSDumpReplayer::RenderUI()
 	DRAW_LINE(font, font_size, text.c_str(), IM_COL32(255, 255, 255, 255));
 
 	text.clear();
-	fmt::format_to(std::back_inserter(text), "Packet Number: {}/{}", s_current_packet, static_cast<u32>(s_dump_file->GetPackets().size()));
+	const u64 first_packet = s_dump_file->GetFrameIndexEntry(s_dump_file->GetFirstLoadedFrame()).packet;
+	const u64 total_packets = s_dump_file->GetFrameIndexEntry(s_dump_file->GetFrameCount()).packet;
+	fmt::format_to(std::back_inserter(text), "Packet Number: {}/{}", first_packet + s_current_packet, total_packets);
 	DRAW_LINE(font, font_size, text.c_str(), IM_COL32(255, 255, 255, 255));
 
 #undef DRAW_LINE
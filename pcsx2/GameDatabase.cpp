@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
 // SPDX-License-Identifier: GPL-3.0+
 
+#include "BuildVersion.h"
 #include "GameDatabase.h"
 #include "GS/GS.h"
 #include "Host.h"
@@ -11,6 +12,7 @@
 #include "common/EnumOps.h"
 #include "common/Error.h"
 #include "common/FileSystem.h"
+#include "common/HeterogeneousContainers.h"
 #include "common/Path.h"
 #include "common/StringUtil.h"
 #include "common/Timer.h"
@@ -19,9 +21,12 @@
 #include <sstream>
 #include "fmt/format.h"
 #include "fmt/ranges.h"
+#include <algorithm>
 #include <fstream>
 #include <mutex>
 #include <optional>
+#include <type_traits>
+#include <zlib.h>
 
 namespace GameDatabaseSchema
 {
@@ -34,9 +39,12 @@ namespace GameDatabase
 {
 	static void parseAndInsert(const std::string_view serial, const ryml::NodeRef& node);
 	static void initDatabase();
+	static bool loadGameDBSnapshot(const std::string& path, const std::string_view source);
+	static void saveGameDBSnapshot(const std::string& path, const std::string_view source);
 } // namespace GameDatabase
 
 static constexpr char GAMEDB_YAML_FILE_NAME[] = "GameIndex.yaml";
+static constexpr char GAMEDB_SNAPSHOT_FILE_NAME[] = "gamedb.cache";
 
 static std::unordered_map<std::string, GameDatabaseSchema::GameEntry> s_game_db;
 static std::once_flag s_load_once_flag;
@@ -1015,6 +1023,400 @@ void GameDatabaseSchema::GameEntry::applyGSHardwareFixes(Pcsx2Config::GSOptions&
 	}
 }
 
+// --------------------------------------------------------------------------------------
+//  Database Snapshots
+// --------------------------------------------------------------------------------------
+// Parsing the YAML databases takes a good chunk of startup, so the parsed result is written to the
+// cache directory and read back instead, until the YAML file's contents or the build change. Enum
+// values are range checked when read back, so a damaged snapshot can't produce an invalid fix.
+// Layout: [SnapshotHeader][records][string pool]. The file is flat, with no pointers, and strings in
+// records are (offset, length) pairs into the pool, which stores each distinct string once.
+// Bump the version whenever what gets written for an entry changes.
+
+namespace
+{
+	struct SnapshotHeader
+	{
+		u32 magic;
+		u32 version;
+		u64 source_size;
+		u32 source_crc;
+		u32 build_crc;
+		u32 record_count;
+		u32 records_size;
+		u32 pool_size;
+		u32 reserved;
+	};
+
+	static u32 GetSourceCRC(const std::string_view source)
+	{
+		return static_cast<u32>(crc32(0, reinterpret_cast<const Bytef*>(source.data()), static_cast<uInt>(source.size())));
+	}
+
+	// Enum values and record layouts can change between builds without the YAML changing.
+	static u32 GetBuildCRC()
+	{
+		const std::string_view hash(BuildVersion::GitHash);
+		return static_cast<u32>(crc32(0, reinterpret_cast<const Bytef*>(hash.data()), static_cast<uInt>(hash.size())));
+	}
+
+	class SnapshotWriter
+	{
+	public:
+		template <typename T>
+		void Write(T value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			const size_t pos = m_records.size();
+			m_records.resize(pos + sizeof(T));
+			std::memcpy(m_records.data() + pos, &value, sizeof(T));
+		}
+
+		void WriteString(const std::string_view str)
+		{
+			u32 offset;
+			if (const auto iter = m_pool_offsets.find(str); iter != m_pool_offsets.end())
+			{
+				offset = iter->second;
+			}
+			else
+			{
+				offset = static_cast<u32>(m_pool.size());
+				m_pool.append(str);
+				m_pool_offsets.emplace(str, offset);
+			}
+
+			Write<u32>(offset);
+			Write<u32>(static_cast<u32>(str.length()));
+		}
+
+		bool Save(const std::string& path, u32 magic, u32 version, const std::string_view source, u32 record_count)
+		{
+			SnapshotHeader header = {};
+			header.magic = magic;
+			header.version = version;
+			header.source_size = static_cast<u64>(source.size());
+			header.source_crc = GetSourceCRC(source);
+			header.build_crc = GetBuildCRC();
+			header.record_count = record_count;
+			header.records_size = static_cast<u32>(m_records.size());
+			header.pool_size = static_cast<u32>(m_pool.size());
+
+			std::vector<u8> data(sizeof(header) + m_records.size() + m_pool.size());
+			std::memcpy(data.data(), &header, sizeof(header));
+			std::memcpy(data.data() + sizeof(header), m_records.data(), m_records.size());
+			std::memcpy(data.data() + sizeof(header) + m_records.size(), m_pool.data(), m_pool.size());
+			return FileSystem::WriteBinaryFile(path.c_str(), data.data(), data.size());
+		}
+
+	private:
+		std::vector<u8> m_records;
+		std::string m_pool;
+		UnorderedStringMap<u32> m_pool_offsets;
+	};
+
+	class SnapshotReader
+	{
+	public:
+		/// Returns false if the snapshot is missing, damaged, or was made from a different source file or build.
+		bool Open(const std::string& path, u32 magic, u32 version, const std::string_view source)
+		{
+			std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(path.c_str());
+			if (!data.has_value() || data->size() < sizeof(SnapshotHeader))
+				return false;
+
+			SnapshotHeader header;
+			std::memcpy(&header, data->data(), sizeof(header));
+			if (header.magic != magic || header.version != version ||
+				header.source_size != static_cast<u64>(source.size()) || header.build_crc != GetBuildCRC() ||
+				header.source_crc != GetSourceCRC(source) ||
+				data->size() != sizeof(header) + static_cast<u64>(header.records_size) + header.pool_size)
+			{
+				return false;
+			}
+
+			m_data = std::move(data.value());
+			m_pos = sizeof(header);
+			m_records_end = sizeof(header) + header.records_size;
+			m_record_count = header.record_count;
+			return true;
+		}
+
+		u32 GetRecordCount() const { return m_record_count; }
+		bool IsAtEnd() const { return (m_pos == m_records_end); }
+
+		template <typename T>
+		bool Read(T* value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			if ((m_records_end - m_pos) < sizeof(T))
+				return false;
+
+			std::memcpy(value, m_data.data() + m_pos, sizeof(T));
+			m_pos += sizeof(T);
+			return true;
+		}
+
+		bool ReadString(std::string* str)
+		{
+			u32 offset, length;
+			if (!Read(&offset) || !Read(&length))
+				return false;
+
+			const size_t pool_size = m_data.size() - m_records_end;
+			if (offset > pool_size || length > (pool_size - offset))
+				return false;
+
+			str->assign(reinterpret_cast<const char*>(m_data.data() + m_records_end + offset), length);
+			return true;
+		}
+
+		/// Reads an enum, failing if the value is outside min..max.
+		template <typename T>
+		bool ReadEnum(T* value, T min, T max)
+		{
+			using U = std::underlying_type_t<T>;
+			U raw;
+			if (!Read(&raw) || raw < static_cast<U>(min) || raw > static_cast<U>(max))
+				return false;
+
+			*value = static_cast<T>(raw);
+			return true;
+		}
+
+		template <typename T>
+		bool ReadCount(T* count)
+		{
+			// Every element takes at least a byte, so anything larger than the remaining data is damage.
+			return Read(count) && (*count <= (m_records_end - m_pos));
+		}
+
+	private:
+		std::vector<u8> m_data;
+		size_t m_pos = 0;
+		size_t m_records_end = 0;
+		u32 m_record_count = 0;
+	};
+} // namespace
+
+static std::string getSnapshotPath(const char* name)
+{
+	return EmuFolders::Cache.empty() ? std::string() : Path::Combine(EmuFolders::Cache, name);
+}
+
+static constexpr u32 GAMEDB_SNAPSHOT_MAGIC = 0x53424447; // GDBS
+static constexpr u32 GAMEDB_SNAPSHOT_VERSION = 2;
+
+static void writeGameEntry(SnapshotWriter& writer, const std::string& serial, const GameDatabaseSchema::GameEntry& entry)
+{
+	writer.WriteString(serial);
+	writer.WriteString(entry.name);
+	writer.WriteString(entry.name_sort);
+	writer.WriteString(entry.name_en);
+	writer.WriteString(entry.region);
+	writer.Write(entry.compat);
+	writer.Write(entry.eeRoundMode);
+	writer.Write(entry.eeDivRoundMode);
+	writer.Write(entry.vu0RoundMode);
+	writer.Write(entry.vu1RoundMode);
+	writer.Write(entry.eeClampMode);
+	writer.Write(entry.vu0ClampMode);
+	writer.Write(entry.vu1ClampMode);
+
+	writer.Write(static_cast<u32>(entry.gameFixes.size()));
+	for (const GamefixId id : entry.gameFixes)
+		writer.Write(id);
+
+	writer.Write(static_cast<u32>(entry.speedHacks.size()));
+	for (const auto& [id, value] : entry.speedHacks)
+	{
+		writer.Write(id);
+		writer.Write(value);
+	}
+
+	writer.Write(static_cast<u32>(entry.gsHWFixes.size()));
+	for (const auto& [id, value] : entry.gsHWFixes)
+	{
+		writer.Write(id);
+		writer.Write(value);
+	}
+
+	writer.Write(static_cast<u32>(entry.memcardFilters.size()));
+	for (const std::string& filter : entry.memcardFilters)
+		writer.WriteString(filter);
+
+	// Sorted, so the same database always produces the same snapshot.
+	std::vector<u32> crcs;
+	crcs.reserve(entry.patches.size());
+	for (const auto& it : entry.patches)
+		crcs.push_back(it.first);
+	std::sort(crcs.begin(), crcs.end());
+	writer.Write(static_cast<u32>(crcs.size()));
+	for (const u32 crc : crcs)
+	{
+		writer.Write(crc);
+		writer.WriteString(entry.patches.find(crc)->second);
+	}
+
+	writer.Write(static_cast<u32>(entry.dynaPatches.size()));
+	for (const Patch::DynamicPatch& patch : entry.dynaPatches)
+	{
+		writer.Write(static_cast<u32>(patch.pattern.size()));
+		for (const Patch::DynamicPatchEntry& pe : patch.pattern)
+			writer.Write(pe);
+		writer.Write(static_cast<u32>(patch.replacement.size()));
+		for (const Patch::DynamicPatchEntry& pe : patch.replacement)
+			writer.Write(pe);
+	}
+}
+
+static bool readGameEntry(SnapshotReader& reader, std::string* serial, GameDatabaseSchema::GameEntry* entry)
+{
+	using GameDatabaseSchema::ClampMode;
+	using GameDatabaseSchema::Compatibility;
+	using GameDatabaseSchema::GSHWFixId;
+
+	// MaxCount and Undefined are how entries without the setting are stored.
+	const auto read_round_mode = [&reader](FPRoundMode* mode) {
+		return reader.ReadEnum(mode, FPRoundMode::Nearest, FPRoundMode::MaxCount);
+	};
+	const auto read_clamp_mode = [&reader](ClampMode* mode) {
+		return reader.ReadEnum(mode, ClampMode::Undefined, ClampMode::Full);
+	};
+
+	if (!reader.ReadString(serial) || !reader.ReadString(&entry->name) || !reader.ReadString(&entry->name_sort) ||
+		!reader.ReadString(&entry->name_en) || !reader.ReadString(&entry->region) ||
+		!reader.ReadEnum(&entry->compat, Compatibility::Unknown, Compatibility::Perfect) ||
+		!read_round_mode(&entry->eeRoundMode) || !read_round_mode(&entry->eeDivRoundMode) ||
+		!read_round_mode(&entry->vu0RoundMode) || !read_round_mode(&entry->vu1RoundMode) ||
+		!read_clamp_mode(&entry->eeClampMode) || !read_clamp_mode(&entry->vu0ClampMode) ||
+		!read_clamp_mode(&entry->vu1ClampMode))
+	{
+		return false;
+	}
+
+	u32 count;
+	if (!reader.ReadCount(&count))
+		return false;
+	entry->gameFixes.resize(count);
+	for (GamefixId& id : entry->gameFixes)
+	{
+		if (!reader.ReadEnum(&id, GamefixId_FIRST, static_cast<GamefixId>(GamefixId_COUNT - 1)))
+			return false;
+	}
+
+	if (!reader.ReadCount(&count))
+		return false;
+	entry->speedHacks.resize(count);
+	for (auto& [id, value] : entry->speedHacks)
+	{
+		if (!reader.ReadEnum(&id, static_cast<SpeedHack>(0), static_cast<SpeedHack>(static_cast<int>(SpeedHack::MaxCount) - 1)) ||
+			!reader.Read(&value))
+		{
+			return false;
+		}
+	}
+
+	if (!reader.ReadCount(&count))
+		return false;
+	entry->gsHWFixes.resize(count);
+	for (auto& [id, value] : entry->gsHWFixes)
+	{
+		if (!reader.ReadEnum(&id, static_cast<GSHWFixId>(0), static_cast<GSHWFixId>(static_cast<u32>(GSHWFixId::Count) - 1)) ||
+			!reader.Read(&value))
+		{
+			return false;
+		}
+	}
+
+	if (!reader.ReadCount(&count))
+		return false;
+	entry->memcardFilters.resize(count);
+	for (std::string& filter : entry->memcardFilters)
+	{
+		if (!reader.ReadString(&filter))
+			return false;
+	}
+
+	if (!reader.ReadCount(&count))
+		return false;
+	entry->patches.reserve(count);
+	for (u32 i = 0; i < count; i++)
+	{
+		u32 crc;
+		std::string patch;
+		if (!reader.Read(&crc) || !reader.ReadString(&patch))
+			return false;
+		entry->patches.emplace(crc, std::move(patch));
+	}
+
+	if (!reader.ReadCount(&count))
+		return false;
+	entry->dynaPatches.resize(count);
+	for (Patch::DynamicPatch& patch : entry->dynaPatches)
+	{
+		for (std::vector<Patch::DynamicPatchEntry>* list : {&patch.pattern, &patch.replacement})
+		{
+			if (!reader.ReadCount(&count))
+				return false;
+			list->resize(count);
+			for (Patch::DynamicPatchEntry& pe : *list)
+			{
+				if (!reader.Read(&pe))
+					return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+bool GameDatabase::loadGameDBSnapshot(const std::string& path, const std::string_view source)
+{
+	SnapshotReader reader;
+	if (path.empty() || !reader.Open(path, GAMEDB_SNAPSHOT_MAGIC, GAMEDB_SNAPSHOT_VERSION, source))
+		return false;
+
+	s_game_db.reserve(reader.GetRecordCount());
+	for (u32 i = 0; i < reader.GetRecordCount(); i++)
+	{
+		std::string serial;
+		GameDatabaseSchema::GameEntry entry;
+		if (!readGameEntry(reader, &serial, &entry))
+			break;
+
+		s_game_db.emplace(std::move(serial), std::move(entry));
+	}
+
+	if (s_game_db.size() != reader.GetRecordCount() || !reader.IsAtEnd())
+	{
+		Console.Warning("GameDB: Snapshot '%s' is damaged, parsing YAML instead.", path.c_str());
+		s_game_db.clear();
+		return false;
+	}
+
+	return true;
+}
+
+void GameDatabase::saveGameDBSnapshot(const std::string& path, const std::string_view source)
+{
+	if (path.empty() || s_game_db.empty())
+		return;
+
+	std::vector<const std::pair<const std::string, GameDatabaseSchema::GameEntry>*> sorted;
+	sorted.reserve(s_game_db.size());
+	for (const auto& it : s_game_db)
+		sorted.push_back(&it);
+	std::sort(sorted.begin(), sorted.end(), [](const auto* lhs, const auto* rhs) { return lhs->first < rhs->first; });
+
+	SnapshotWriter writer;
+	for (const auto* it : sorted)
+		writeGameEntry(writer, it->first, it->second);
+
+	if (!writer.Save(path, GAMEDB_SNAPSHOT_MAGIC, GAMEDB_SNAPSHOT_VERSION, source, static_cast<u32>(sorted.size())))
+		Console.Warning("GameDB: Failed to write snapshot '%s'", path.c_str());
+}
+
 void GameDatabase::initDatabase()
 {
 	const std::string path(Path::Combine(EmuFolders::Resources, GAMEDB_YAML_FILE_NAME));
@@ -1027,6 +1429,10 @@ void GameDatabase::initDatabase()
 		return;
 	}
 
+	const std::string snapshot_path(getSnapshotPath(GAMEDB_SNAPSHOT_FILE_NAME));
+	if (loadGameDBSnapshot(snapshot_path, *buffer))
+		return;
+
 	const ryml::csubstr yaml = ryml::to_csubstr(*buffer);
 
 	Error error;
@@ -1059,6 +1465,8 @@ void GameDatabase::initDatabase()
 			parseAndInsert(serial, n);
 		}
 	}
+
+	saveGameDBSnapshot(snapshot_path, *buffer);
 }
 
 void GameDatabase::ensureLoaded()
@@ -1123,6 +1531,9 @@ struct TrackHashHasher
 };
 
 static constexpr char HASHDB_YAML_FILE_NAME[] = "RedumpDatabase.yaml";
+static constexpr char HASHDB_SNAPSHOT_FILE_NAME[] = "hashdb.cache";
+static constexpr u32 HASHDB_SNAPSHOT_MAGIC = 0x53424448; // HDBS
+static constexpr u32 HASHDB_SNAPSHOT_VERSION = 2;
 std::unordered_map<GameDatabase::TrackHash, u32, TrackHashHasher> s_track_hash_to_entry_map;
 std::vector<GameDatabase::HashDatabaseEntry> s_hash_database;
 
@@ -1172,6 +1583,69 @@ static bool parseHashDatabaseEntry(const ryml::NodeRef& node)
 	return true;
 }
 
+static bool loadHashDatabaseSnapshot(const std::string& path, const std::string_view source)
+{
+	SnapshotReader reader;
+	if (path.empty() || !reader.Open(path, HASHDB_SNAPSHOT_MAGIC, HASHDB_SNAPSHOT_VERSION, source))
+		return false;
+
+	s_hash_database.reserve(reader.GetRecordCount());
+	for (u32 i = 0; i < reader.GetRecordCount(); i++)
+	{
+		GameDatabase::HashDatabaseEntry entry;
+		u32 num_tracks;
+		if (!reader.ReadString(&entry.serial) || !reader.ReadString(&entry.name) || !reader.ReadString(&entry.version) ||
+			!reader.ReadCount(&num_tracks))
+		{
+			break;
+		}
+
+		entry.tracks.resize(num_tracks);
+		bool okay = true;
+		for (GameDatabase::TrackHash& th : entry.tracks)
+			okay = okay && reader.Read(&th);
+		if (!okay)
+			break;
+
+		// Same order as the YAML parse, so duplicate hashes still resolve to the first entry.
+		const u32 index = static_cast<u32>(s_hash_database.size());
+		for (const GameDatabase::TrackHash& th : entry.tracks)
+			s_track_hash_to_entry_map.emplace(th, index);
+
+		s_hash_database.push_back(std::move(entry));
+	}
+
+	if (s_hash_database.size() != reader.GetRecordCount() || !reader.IsAtEnd())
+	{
+		Console.Warning("[HashDatabase] Snapshot '%s' is damaged, parsing YAML instead.", path.c_str());
+		s_track_hash_to_entry_map.clear();
+		s_hash_database.clear();
+		return false;
+	}
+
+	return true;
+}
+
+static void saveHashDatabaseSnapshot(const std::string& path, const std::string_view source)
+{
+	if (path.empty())
+		return;
+
+	SnapshotWriter writer;
+	for (const GameDatabase::HashDatabaseEntry& entry : s_hash_database)
+	{
+		writer.WriteString(entry.serial);
+		writer.WriteString(entry.name);
+		writer.WriteString(entry.version);
+		writer.Write(static_cast<u32>(entry.tracks.size()));
+		for (const GameDatabase::TrackHash& th : entry.tracks)
+			writer.Write(th);
+	}
+
+	if (!writer.Save(path, HASHDB_SNAPSHOT_MAGIC, HASHDB_SNAPSHOT_VERSION, source, static_cast<u32>(s_hash_database.size())))
+		Console.Warning("[HashDatabase] Failed to write snapshot '%s'", path.c_str());
+}
+
 bool GameDatabase::loadHashDatabase()
 {
 	if (!s_hash_database.empty())
@@ -1189,6 +1663,13 @@ bool GameDatabase::loadHashDatabase()
 		return false;
 	}
 
+	const std::string snapshot_path(getSnapshotPath(HASHDB_SNAPSHOT_FILE_NAME));
+	if (loadHashDatabaseSnapshot(snapshot_path, *buffer))
+	{
+		Console.WriteLn(Color_StrongGreen, "[HashDatabase] Loaded snapshot in %.0f ms", load_timer.GetTimeMilliseconds());
+		return true;
+	}
+
 	ryml::csubstr yaml = ryml::to_csubstr(*buffer);
 
 	Error error;
@@ -1220,6 +1701,7 @@ bool GameDatabase::loadHashDatabase()
 	}
 
 	Console.WriteLn(Color_StrongGreen, "[HashDatabase] Loaded YAML in %.0f ms", load_timer.GetTimeMilliseconds());
+	saveHashDatabaseSnapshot(snapshot_path, *buffer);
 	return true;
 }
 
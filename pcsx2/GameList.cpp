@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-3.0+
 
 #include "CDVD/CDVD.h"
+#include "CDVD/IsoFileFormats.h"
 #include "Elfheader.h"
 #include "GameList.h"
 #include "Host.h"
@@ -18,14 +19,18 @@
 #include "common/ProgressCallback.h"
 #include "common/ScopedGuard.h"
 #include "common/StringUtil.h"
+#include "common/Threading.h"
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cctype>
 #include <cstdio>
 #include <ctime>
 #include <fstream>
+#include <optional>
 #include <string_view>
+#include <thread>
 #include <utility>
 
 #ifdef _WIN32
@@ -39,6 +44,8 @@ namespace GameList
 		GAME_LIST_CACHE_SIGNATURE = 0x45434C47,
 		GAME_LIST_CACHE_VERSION = 34,
 
+		MAX_SCAN_THREADS = 8,
+
 
 		PLAYED_TIME_SERIAL_LENGTH = 32,
 		PLAYED_TIME_LAST_TIME_LENGTH = 20, // uint64
@@ -68,6 +75,7 @@ namespace GameList
 	static bool AddFileFromCache(const std::string& path, std::time_t timestamp, const PlayedTimeMap& played_time_map);
 	static bool ScanFile(std::string path, std::time_t timestamp, std::unique_lock<std::recursive_mutex>& lock,
 		const PlayedTimeMap& played_time_map, const INISettingsInterface& custom_attributes_ini);
+	static void AddScannedEntry(Entry entry, const PlayedTimeMap& played_time_map, const INISettingsInterface& custom_attributes_ini);
 
 	static void LoadCache();
 	static bool LoadEntriesFromCache(std::FILE* stream);
@@ -257,18 +265,18 @@ bool GameList::GetIsoSerialAndCRC(const std::string& path, s32* disc_type, std::
 {
 	Error error;
 
-	// This isn't great, we really want to make it all thread-local...
-	CDVD = &CDVDapi_Iso;
-	if (!CDVD->open(path, &error))
+	// Opened privately rather than through the global CDVD, so several files can be probed at once.
+	InputIsoFile iso;
+	if (!iso.Open(path, &error))
 	{
 		Console.Error(fmt::format("(GameList::GetIsoSerialAndCRC) CDVD open of '{}' failed: {}", path, error.GetDescription()));
 		return false;
 	}
 
 	// TODO: we could include the version in the game list?
-	*disc_type = DoCDVDdetectDiskType();
-	cdvdGetDiscInfo(serial, nullptr, nullptr, crc, nullptr);
-	DoCDVDclose();
+	*disc_type = cdvdDetectIsoDiskType(&iso);
+	cdvdGetDiscInfo(&iso, serial, nullptr, nullptr, crc, nullptr);
+	iso.Close();
 	return true;
 }
 
@@ -632,11 +640,6 @@ bool GameList::WriteEntryToCache(const Entry* entry)
 	result &= WriteU64(s_cache_write_stream, static_cast<u64>(entry->last_modified_time));
 	result &= WriteU32(s_cache_write_stream, entry->crc);
 	result &= WriteU8(s_cache_write_stream, static_cast<u8>(entry->compatibility_rating));
-
-	// flush after each entry, that way we don't end up with a corrupted file if we crash scanning.
-	if (result)
-		result = (std::fflush(s_cache_write_stream) == 0);
-
 	return result;
 }
 
@@ -702,32 +705,114 @@ void GameList::ScanDirectory(const char* path, bool recursive, bool only_cache,
 					(FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_HIDDEN_FILES),
 		&files, progress);
 
-	u32 files_scanned = 0;
 	progress->SetProgressRange(static_cast<u32>(files.size()));
 	progress->SetProgressValue(0);
 
-	for (FILESYSTEM_FIND_DATA& ffd : files)
+	// Pick up everything we already know about first, only files which aren't in the cache need probing.
+	std::vector<FILESYSTEM_FIND_DATA*> to_scan;
+	{
+		std::unique_lock lock(s_mutex);
+		for (FILESYSTEM_FIND_DATA& ffd : files)
+		{
+			if (progress->IsCancelled() || !GameList::IsScannableFilename(ffd.FileName) || IsPathExcluded(excluded_paths, ffd.FileName))
+			{
+				continue;
+			}
+
+			if (GetEntryForPath(ffd.FileName.c_str()) || AddFileFromCache(ffd.FileName, ffd.ModificationTime, played_time_map) || only_cache)
+			{
+				continue;
+			}
+
+			to_scan.push_back(&ffd);
+		}
+	}
+
+	const u32 files_skipped = static_cast<u32>(files.size() - to_scan.size());
+	progress->SetProgressValue(files_skipped);
+
+	if (!to_scan.empty() && !progress->IsCancelled())
 	{
-		files_scanned++;
+		// Probing is mostly waiting on disk reads and decompression, so spread it across a few threads.
+		// Results are kept in directory order, so the list and cache come out the same as a serial scan.
+		std::vector<std::optional<Entry>> results(to_scan.size());
+		std::atomic<size_t> next_index{0};
+		std::atomic<u32> files_done{0};
+		std::atomic_bool cancelled{false};
+
+		// Returns false once there's nothing left to claim.
+		const auto scan_next_file = [&to_scan, &results, &next_index, &files_done, &cancelled]() {
+			const size_t index = next_index.fetch_add(1, std::memory_order_relaxed);
+			if (index >= to_scan.size() || cancelled.load(std::memory_order_relaxed))
+				return false;
+
+			const FILESYSTEM_FIND_DATA* ffd = to_scan[index];
+			DevCon.WriteLn("Scanning '%s'...", ffd->FileName.c_str());
+
+			Entry entry;
+			if (PopulateEntryFromPath(ffd->FileName, &entry))
+			{
+				entry.last_modified_time = ffd->ModificationTime;
+				results[index] = std::move(entry);
+			}
 
-		if (progress->IsCancelled() || !GameList::IsScannableFilename(ffd.FileName) || IsPathExcluded(excluded_paths, ffd.FileName))
+			files_done.fetch_add(1, std::memory_order_release);
+			return true;
+		};
+
+		const u32 num_threads = std::min(std::clamp(std::thread::hardware_concurrency(), 1u, static_cast<u32>(MAX_SCAN_THREADS)),
+			static_cast<u32>(to_scan.size()));
+		std::vector<std::thread> threads;
+		threads.reserve(num_threads - 1);
+		for (u32 i = 1; i < num_threads; i++)
 		{
-			continue;
+			threads.emplace_back([&scan_next_file]() {
+				Threading::SetNameOfCurrentThread("Game List Scan");
+				while (scan_next_file())
+					;
+			});
 		}
 
-		std::unique_lock lock(s_mutex);
-		if (GetEntryForPath(ffd.FileName.c_str()) || AddFileFromCache(ffd.FileName, ffd.ModificationTime, played_time_map) || only_cache)
+		// The calling thread does its share too, and keeps the progress display up to date in between files.
+		do
 		{
-			continue;
+			const size_t index = next_index.load(std::memory_order_relaxed);
+			if (index < to_scan.size())
+			{
+				const std::string_view filename = Path::GetFileName(to_scan[index]->FileName);
+				progress->SetStatusText(fmt::format(TRANSLATE_FS("GameList", "Scanning {}..."), filename).c_str());
+			}
+
+			progress->SetProgressValue(files_skipped + files_done.load(std::memory_order_acquire));
+			if (progress->IsCancelled())
+				cancelled.store(true, std::memory_order_relaxed);
+		} while (scan_next_file());
+
+		for (std::thread& thread : threads)
+			thread.join();
+
+		// Write the whole batch to the cache at once, invalid entries included so we don't probe them again next time.
+		if (s_cache_write_stream || OpenCacheForWriting())
+		{
+			for (const std::optional<Entry>& entry : results)
+			{
+				if (entry.has_value() && !WriteEntryToCache(&entry.value()))
+					Console.Warning("Failed to write entry '%s' to cache", entry->path.c_str());
+			}
+
+			if (std::fflush(s_cache_write_stream) != 0)
+				Console.Warning("Failed to flush game list cache");
 		}
 
-		const std::string_view filename = Path::GetFileName(ffd.FileName);
-		progress->SetStatusText(fmt::format(TRANSLATE_FS("GameList", "Scanning {}..."), filename.data()).c_str());
-		ScanFile(std::move(ffd.FileName), ffd.ModificationTime, lock, played_time_map, custom_attributes_ini);
-		progress->SetProgressValue(files_scanned);
+		std::unique_lock lock(s_mutex);
+		for (std::optional<Entry>& entry : results)
+		{
+			if (entry.has_value() && entry->type != EntryType::Invalid)
+				AddScannedEntry(std::move(entry.value()), played_time_map, custom_attributes_ini);
+		}
 	}
 
-	progress->SetProgressValue(files_scanned);
+	progress->SetProgressValue(static_cast<u32>(files.size()));
 	progress->PopState();
 }
 
@@ -762,23 +847,30 @@ bool GameList::ScanFile(std::string path, std::time_t timestamp, std::unique_loc
 
 	Entry entry;
 	if (!PopulateEntryFromPath(path, &entry))
+	{
+		lock.lock();
 		return false;
+	}
 
 	entry.last_modified_time = timestamp;
 
 	if (s_cache_write_stream || OpenCacheForWriting())
 	{
-		if (!WriteEntryToCache(&entry))
+		if (!WriteEntryToCache(&entry) || std::fflush(s_cache_write_stream) != 0)
 			Console.Warning("Failed to write entry '%s' to cache", entry.path.c_str());
 	}
 
-	if (entry.type == EntryType::Invalid)
-	{
-		// don't add invalid entries to list
-		lock.lock();
-		return true;
-	}
+	lock.lock();
+
+	// don't add invalid entries to list
+	if (entry.type != EntryType::Invalid)
+		AddScannedEntry(std::move(entry), played_time_map, custom_attributes_ini);
 
+	return true;
+}
+
+void GameList::AddScannedEntry(Entry entry, const PlayedTimeMap& played_time_map, const INISettingsInterface& custom_attributes_ini)
+{
 	const auto iter = played_time_map.find(entry.serial);
 	if (iter != played_time_map.end())
 	{
@@ -801,8 +893,6 @@ bool GameList::ScanFile(std::string path, std::time_t timestamp, std::unique_loc
 		}
 	}
 
-	lock.lock();
-
 	// remove if present
 	auto it = std::find_if(
 		s_entries.begin(), s_entries.end(), [&entry](const Entry& existing_entry) { return (existing_entry.path == entry.path); });
@@ -810,7 +900,6 @@ bool GameList::ScanFile(std::string path, std::time_t timestamp, std::unique_loc
 		s_entries.erase(it);
 
 	s_entries.push_back(std::move(entry));
-	return true;
 }
 
 std::unique_lock<std::recursive_mutex> GameList::GetLock()
@@ -287,6 +287,21 @@ DEFINE_HOTKEY("LoadBackupStateFromSlot", TRANSLATE_NOOP("Hotkeys", "Save States"
 		if (!pressed && VMManager::HasValidVM())
 			SaveStateSelectorUI::LoadCurrentBackupSlot();
 	})
+DEFINE_HOTKEY("RewindState", TRANSLATE_NOOP("Hotkeys", "Save States"),
+	TRANSLATE_NOOP("Hotkeys", "Rewind"), [](s32 pressed) {
+		if (!pressed && VMManager::HasValidVM() && EmuConfig.Savestate.RewindEnable)
+		{
+			Host::RunOnCPUThread([]() {
+				Error error;
+				if (!VMManager::RewindState(&error))
+				{
+					Host::AddIconOSDMessage("RewindState", ICON_FA_TRIANGLE_EXCLAMATION,
+						fmt::format(TRANSLATE_FS("Hotkeys", "Failed to rewind: {}"), error.GetDescription()),
+						Host::OSD_INFO_DURATION);
+				}
+			});
+		}
+	})
 DEFINE_HOTKEY("SaveStateAndSelectNextSlot", TRANSLATE_NOOP("Hotkeys", "Save States"),
 	TRANSLATE_NOOP("Hotkeys", "Save State and Select Next Slot"), [](s32 pressed) {
 		if (!pressed && VMManager::HasValidVM())
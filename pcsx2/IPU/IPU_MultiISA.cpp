@@ -65,7 +65,6 @@ alignas(16) const mpeg2_scan_pack mpeg2_scan = make_scan_pack();
 MULTI_ISA_UNSHARED_START
 
 static void ipu_csc(macroblock_8& mb8, macroblock_rgb32& rgb32, int sgn);
-static void ipu_vq(macroblock_rgb16& rgb16, u8* indx4);
 
 // --------------------------------------------------------------------------------------
 //  Buffer reader
@@ -206,6 +205,159 @@ __ri static u8 getBits8(u8 *address, bool advance)
  * column inputs are 16-bit values.
  */
 
+#if defined(ARCH_X86)
+
+// The IDCT below computes exactly the same values as the scalar version, with each 32-bit
+// lane holding one row (first pass) or column (second pass). Results are truncated to
+// 16 bits between the passes, as storing to the s16 block does in the scalar version.
+
+__fi static void IDCT_Transpose(__m128i* r)
+{
+	const __m128i a0 = _mm_unpacklo_epi16(r[0], r[1]);
+	const __m128i a1 = _mm_unpackhi_epi16(r[0], r[1]);
+	const __m128i a2 = _mm_unpacklo_epi16(r[2], r[3]);
+	const __m128i a3 = _mm_unpackhi_epi16(r[2], r[3]);
+	const __m128i a4 = _mm_unpacklo_epi16(r[4], r[5]);
+	const __m128i a5 = _mm_unpackhi_epi16(r[4], r[5]);
+	const __m128i a6 = _mm_unpacklo_epi16(r[6], r[7]);
+	const __m128i a7 = _mm_unpackhi_epi16(r[6], r[7]);
+
+	const __m128i b0 = _mm_unpacklo_epi32(a0, a2);
+	const __m128i b1 = _mm_unpackhi_epi32(a0, a2);
+	const __m128i b2 = _mm_unpacklo_epi32(a1, a3);
+	const __m128i b3 = _mm_unpackhi_epi32(a1, a3);
+	const __m128i b4 = _mm_unpacklo_epi32(a4, a6);
+	const __m128i b5 = _mm_unpackhi_epi32(a4, a6);
+	const __m128i b6 = _mm_unpacklo_epi32(a5, a7);
+	const __m128i b7 = _mm_unpackhi_epi32(a5, a7);
+
+	r[0] = _mm_unpacklo_epi64(b0, b4);
+	r[1] = _mm_unpackhi_epi64(b0, b4);
+	r[2] = _mm_unpacklo_epi64(b1, b5);
+	r[3] = _mm_unpackhi_epi64(b1, b5);
+	r[4] = _mm_unpacklo_epi64(b2, b6);
+	r[5] = _mm_unpackhi_epi64(b2, b6);
+	r[6] = _mm_unpacklo_epi64(b3, b7);
+	r[7] = _mm_unpackhi_epi64(b3, b7);
+}
+
+// Same as the scalar BUTTERFLY, which works out to t0 = w0 * d0 + w1 * d1 and t1 = w0 * d1 - w1 * d0.
+// d01 holds the 16-bit d0/d1 pairs, and neither product can overflow, so pmaddwd gives identical results.
+__fi static void BUTTERFLY(__m128i& t0, __m128i& t1, int w0, int w1, __m128i d01)
+{
+	t0 = _mm_madd_epi16(d01, _mm_set1_epi32((w1 << 16) | w0));
+	t1 = _mm_madd_epi16(d01, _mm_set1_epi32((w0 << 16) | (-w1 & 0xFFFF)));
+}
+
+// Packs two sets of four 32-bit results to 16 bits, discarding the upper bits rather than saturating.
+__fi static __m128i IDCT_Pack(__m128i lo, __m128i hi)
+{
+	lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+	hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+	return _mm_packs_epi32(lo, hi);
+}
+
+// v[i] holds coefficient i of each of the eight rows or columns being transformed.
+template <bool column_pass>
+__fi static void IDCT_Pass(__m128i* v)
+{
+	constexpr int shift = column_pass ? 17 : 8;
+	__m128i out[2][8];
+
+	for (int half = 0; half < 2; half++)
+	{
+		const auto unpack = [half](__m128i a, __m128i b) {
+			return half ? _mm_unpackhi_epi16(a, b) : _mm_unpacklo_epi16(a, b);
+		};
+
+		__m128i a0, a1, a2, a3;
+		{
+			const __m128i x0 = _mm_cvtepi16_epi32(half ? _mm_unpackhi_epi64(v[0], v[0]) : v[0]);
+			const __m128i x2 = _mm_cvtepi16_epi32(half ? _mm_unpackhi_epi64(v[2], v[2]) : v[2]);
+			const __m128i d0 = _mm_add_epi32(_mm_slli_epi32(x0, 11), _mm_set1_epi32(column_pass ? 65536 : 128));
+			const __m128i d2 = _mm_slli_epi32(x2, 11);
+			const __m128i t0 = _mm_add_epi32(d0, d2);
+			const __m128i t1 = _mm_sub_epi32(d0, d2);
+			__m128i t2, t3;
+			BUTTERFLY(t2, t3, W6, W2, unpack(v[3], v[1]));
+			a0 = _mm_add_epi32(t0, t2);
+			a1 = _mm_add_epi32(t1, t3);
+			a2 = _mm_sub_epi32(t1, t3);
+			a3 = _mm_sub_epi32(t0, t2);
+		}
+
+		__m128i b0, b1, b2, b3;
+		{
+			__m128i t0, t1, t2, t3;
+			BUTTERFLY(t0, t1, W7, W1, unpack(v[7], v[4]));
+			BUTTERFLY(t2, t3, W3, W5, unpack(v[5], v[6]));
+			b0 = _mm_add_epi32(t0, t2);
+			b3 = _mm_add_epi32(t1, t3);
+			t0 = _mm_sub_epi32(t0, t2);
+			t1 = _mm_sub_epi32(t1, t3);
+
+			const __m128i c181 = _mm_set1_epi32(181);
+			if constexpr (column_pass)
+			{
+				t0 = _mm_srai_epi32(t0, 8);
+				t1 = _mm_srai_epi32(t1, 8);
+				b1 = _mm_mullo_epi32(_mm_add_epi32(t0, t1), c181);
+				b2 = _mm_mullo_epi32(_mm_sub_epi32(t0, t1), c181);
+			}
+			else
+			{
+				b1 = _mm_srai_epi32(_mm_mullo_epi32(_mm_add_epi32(t0, t1), c181), 8);
+				b2 = _mm_srai_epi32(_mm_mullo_epi32(_mm_sub_epi32(t0, t1), c181), 8);
+			}
+		}
+
+		out[half][0] = _mm_srai_epi32(_mm_add_epi32(a0, b0), shift);
+		out[half][1] = _mm_srai_epi32(_mm_add_epi32(a1, b1), shift);
+		out[half][2] = _mm_srai_epi32(_mm_add_epi32(a2, b2), shift);
+		out[half][3] = _mm_srai_epi32(_mm_add_epi32(a3, b3), shift);
+		out[half][4] = _mm_srai_epi32(_mm_sub_epi32(a3, b3), shift);
+		out[half][5] = _mm_srai_epi32(_mm_sub_epi32(a2, b2), shift);
+		out[half][6] = _mm_srai_epi32(_mm_sub_epi32(a1, b1), shift);
+		out[half][7] = _mm_srai_epi32(_mm_sub_epi32(a0, b0), shift);
+	}
+
+	for (int i = 0; i < 8; i++)
+		v[i] = IDCT_Pack(out[0][i], out[1][i]);
+}
+
+// Transforms the block, leaving the result rows in r and the block cleared.
+__ri static void IDCT_Block(s16* block, __m128i* r)
+{
+	const __m128i zero = _mm_setzero_si128();
+	for (int i = 0; i < 8; i++)
+	{
+		r[i] = _mm_load_si128(reinterpret_cast<const __m128i*>(block + 8 * i));
+		_mm_store_si128(reinterpret_cast<__m128i*>(block + 8 * i), zero);
+	}
+
+	IDCT_Transpose(r);
+	IDCT_Pass<false>(r);
+	IDCT_Transpose(r);
+	IDCT_Pass<true>(r);
+}
+
+__ri static void IDCT_Copy(s16* block, u8* dest, const int stride)
+{
+	__m128i r[8];
+	IDCT_Block(block, r);
+
+	// Saturating to 0..255 is the same as the clip table, without its limited input range.
+	for (int i = 0; i < 8; i++)
+	{
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(dest), _mm_packus_epi16(r[i], r[i]));
+		dest += stride;
+	}
+}
+
+#endif
+
+// Scalar version, used where there is no vector version and as the reference the vector version is tested against.
+
 __fi static void BUTTERFLY(int& t0, int& t1, int w0, int w1, int d0, int d1)
 {
 	int tmp = w0 * (d0 + d1);
@@ -322,6 +474,8 @@ __ri static void IDCT_Block(s16* block)
 	}
 }
 
+#if !defined(ARCH_X86)
+
 __ri static void IDCT_Copy(s16* block, u8* dest, const int stride)
 {
 	IDCT_Block(block);
@@ -344,6 +498,7 @@ __ri static void IDCT_Copy(s16* block, u8* dest, const int stride)
 	}
 }
 
+#endif
 
 // stride = increment for dest in 16-bit units (typically either 8 [128 bits] or 16 [256 bits]).
 __ri static void IDCT_Add(const int last, s16* block, s16* dest, const int stride)
@@ -352,6 +507,13 @@ __ri static void IDCT_Add(const int last, s16* block, s16* dest, const int strid
 
 	if (last != 129 || (block[0] & 7) == 4)
 	{
+#if defined(ARCH_X86)
+		__m128i r[8];
+		IDCT_Block(block, r);
+
+		for (int i = 0; i < 8; i++)
+			_mm_store_si128(reinterpret_cast<__m128i*>(dest + stride * i), r[i]);
+#else
 		IDCT_Block(block);
 
 		const r128 zero = r128_zero();
@@ -363,6 +525,7 @@ __ri static void IDCT_Add(const int last, s16* block, s16* dest, const int strid
 			dest += stride;
 			block += 8;
 		}
+#endif
 	}
 	else
 	{
@@ -375,6 +538,26 @@ __ri static void IDCT_Add(const int last, s16* block, s16* dest, const int strid
 	}
 }
 
+void ipu_idct_reference(s16* block, s16* out)
+{
+	IDCT_Block(block);
+	std::memcpy(out, block, sizeof(s16) * 64);
+	std::memset(block, 0, sizeof(s16) * 64);
+}
+
+void ipu_idct(s16* block, s16* out)
+{
+#if defined(ARCH_X86)
+	__m128i r[8];
+	IDCT_Block(block, r);
+
+	for (int i = 0; i < 8; i++)
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8 * i), r[i]);
+#else
+	ipu_idct_reference(block, out);
+#endif
+}
+
 /* Bitstream and buffer needs to be reallocated in order for successful
 	reading of the old data. Here the old data stored in the 2nd slot
 	of the internal buffer is copied to 1st slot, and the new data read
@@ -1909,34 +2092,6 @@ __fi static void ipu_csc(macroblock_8& mb8, macroblock_rgb32& rgb32, int sgn)
 	}
 }
 
-__fi static void ipu_vq(macroblock_rgb16& rgb16, u8* indx4)
-{
-	const auto closest_index = [&](int i, int j) {
-		u8 index = 0;
-		int min_distance = std::numeric_limits<int>::max();
-		for (u8 k = 0; k < 16; ++k)
-		{
-			const int dr = rgb16.c[i][j].r - g_ipu_vqclut[k].r;
-			const int dg = rgb16.c[i][j].g - g_ipu_vqclut[k].g;
-			const int db = rgb16.c[i][j].b - g_ipu_vqclut[k].b;
-			const int distance = dr * dr + dg * dg + db * db;
-
-			// XXX: If two distances are the same which index is used?
-			if (min_distance > distance)
-			{
-				index = k;
-				min_distance = distance;
-			}
-		}
-
-		return index;
-	};
-
-	for (int i = 0; i < 16; ++i)
-		for (int j = 0; j < 8; ++j)
-			indx4[i * 8 + j] = closest_index(i, 2 * j + 1) << 4 | closest_index(i, 2 * j);
-}
-
 __noinline void IPUWorker()
 {
 	pxAssert(ipuRegs.ctrl.BUSY);
@@ -143,6 +143,13 @@ alignas(16) extern tIPU_BP g_BP;
 
 MULTI_ISA_DEF(
 	extern void ipu_dither(const macroblock_rgb32& rgb32, macroblock_rgb16& rgb16, int dte);
+	extern void ipu_dither_reference(const macroblock_rgb32& rgb32, macroblock_rgb16& rgb16, int dte);
+	extern void ipu_vq(const macroblock_rgb16& rgb16, u8* indx4);
+	extern void ipu_vq_reference(const macroblock_rgb16& rgb16, u8* indx4);
+
+	// Inverse DCT of a 16-byte aligned block of 64 coefficients into out, clearing the block.
+	extern void ipu_idct(s16* block, s16* out);
+	extern void ipu_idct_reference(s16* block, s16* out);
 
 	void IPUWorker();
 )
@@ -10,21 +10,37 @@
 
 MULTI_ISA_UNSHARED_START
 
-void ipu_dither_reference(const macroblock_rgb32 &rgb32, macroblock_rgb16 &rgb16, int dte);
-
 #if defined(_M_X86)
 void ipu_dither_sse2(const macroblock_rgb32 &rgb32, macroblock_rgb16 &rgb16, int dte);
+void ipu_vq_sse4(const macroblock_rgb16 &rgb16, u8 *indx4);
+#if _M_SSE >= 0x501
+void ipu_dither_avx2(const macroblock_rgb32 &rgb32, macroblock_rgb16 &rgb16, int dte);
+void ipu_vq_avx2(const macroblock_rgb16 &rgb16, u8 *indx4);
+#endif
 #endif
 
 __ri void ipu_dither(const macroblock_rgb32 &rgb32, macroblock_rgb16 &rgb16, int dte)
 {
-#if defined(_M_X86)
+#if defined(_M_X86) && _M_SSE >= 0x501
+    ipu_dither_avx2(rgb32, rgb16, dte);
+#elif defined(_M_X86)
     ipu_dither_sse2(rgb32, rgb16, dte);
 #else
     ipu_dither_reference(rgb32, rgb16, dte);
 #endif
 }
 
+__ri void ipu_vq(const macroblock_rgb16 &rgb16, u8 *indx4)
+{
+#if defined(_M_X86) && _M_SSE >= 0x501
+    ipu_vq_avx2(rgb16, indx4);
+#elif defined(_M_X86)
+    ipu_vq_sse4(rgb16, indx4);
+#else
+    ipu_vq_reference(rgb16, indx4);
+#endif
+}
+
 __ri void ipu_dither_reference(const macroblock_rgb32 &rgb32, macroblock_rgb16 &rgb16, int dte)
 {
     if (dte) {
@@ -60,6 +76,33 @@ __ri void ipu_dither_reference(const macroblock_rgb32 &rgb32, macroblock_rgb16 &
     }
 }
 
+// conforming implementation for reference, do not optimise
+__ri void ipu_vq_reference(const macroblock_rgb16 &rgb16, u8 *indx4)
+{
+    const auto closest_index = [&](int i, int j) {
+        u8 index = 0;
+        int min_distance = std::numeric_limits<int>::max();
+        for (u8 k = 0; k < 16; ++k) {
+            const int dr = rgb16.c[i][j].r - g_ipu_vqclut[k].r;
+            const int dg = rgb16.c[i][j].g - g_ipu_vqclut[k].g;
+            const int db = rgb16.c[i][j].b - g_ipu_vqclut[k].b;
+            const int distance = dr * dr + dg * dg + db * db;
+
+            // XXX: If two distances are the same which index is used?
+            if (min_distance > distance) {
+                index = k;
+                min_distance = distance;
+            }
+        }
+
+        return index;
+    };
+
+    for (int i = 0; i < 16; ++i)
+        for (int j = 0; j < 8; ++j)
+            indx4[i * 8 + j] = closest_index(i, 2 * j + 1) << 4 | closest_index(i, 2 * j);
+}
+
 #if defined(_M_X86)
 
 __ri void ipu_dither_sse2(const macroblock_rgb32 &rgb32, macroblock_rgb16 &rgb16, int dte)
@@ -119,6 +162,158 @@ __ri void ipu_dither_sse2(const macroblock_rgb32 &rgb32, macroblock_rgb16 &rgb16
     }
 }
 
+
+// The largest possible distance is 3 * 31 * 31, so the whole search can be done in 16-bit lanes.
+// Ties keep the lowest index like the reference, hence the strict compare rather than a min.
+__ri void ipu_vq_sse4(const macroblock_rgb16 &rgb16, u8 *indx4)
+{
+    const __m128i channel_mask = _mm_set1_epi16(0x1f);
+    const __m128i index_mask = _mm_set1_epi32(0xff);
+
+    __m128i clut_r[16], clut_g[16], clut_b[16];
+    for (int k = 0; k < 16; ++k) {
+        clut_r[k] = _mm_set1_epi16(g_ipu_vqclut[k].r);
+        clut_g[k] = _mm_set1_epi16(g_ipu_vqclut[k].g);
+        clut_b[k] = _mm_set1_epi16(g_ipu_vqclut[k].b);
+    }
+
+    const auto closest_index = [&](const __m128i rgba16) {
+        const __m128i r = _mm_and_si128(rgba16, channel_mask);
+        const __m128i g = _mm_and_si128(_mm_srli_epi16(rgba16, 5), channel_mask);
+        const __m128i b = _mm_and_si128(_mm_srli_epi16(rgba16, 10), channel_mask);
+
+        __m128i index = _mm_setzero_si128();
+        __m128i min_distance = _mm_set1_epi16(0x7fff);
+        for (int k = 0; k < 16; ++k) {
+            const __m128i dr = _mm_sub_epi16(r, clut_r[k]);
+            const __m128i dg = _mm_sub_epi16(g, clut_g[k]);
+            const __m128i db = _mm_sub_epi16(b, clut_b[k]);
+            const __m128i distance = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(dr, dr), _mm_mullo_epi16(dg, dg)), _mm_mullo_epi16(db, db));
+
+            const __m128i closer = _mm_cmpgt_epi16(min_distance, distance);
+            min_distance = _mm_min_epi16(min_distance, distance);
+            index = _mm_blendv_epi8(index, _mm_set1_epi16(k), closer);
+        }
+
+        // Pair up neighbouring pixels, odd pixel in the high nibble.
+        return _mm_and_si128(_mm_or_si128(index, _mm_srli_epi32(index, 12)), index_mask);
+    };
+
+    for (int i = 0; i < 16; i += 2) {
+        const __m128i row0 = _mm_packs_epi32(
+            closest_index(_mm_load_si128(reinterpret_cast<const __m128i *>(&rgb16.c[i][0]))),
+            closest_index(_mm_load_si128(reinterpret_cast<const __m128i *>(&rgb16.c[i][8]))));
+        const __m128i row1 = _mm_packs_epi32(
+            closest_index(_mm_load_si128(reinterpret_cast<const __m128i *>(&rgb16.c[i + 1][0]))),
+            closest_index(_mm_load_si128(reinterpret_cast<const __m128i *>(&rgb16.c[i + 1][8]))));
+
+        _mm_store_si128(reinterpret_cast<__m128i *>(&indx4[i * 8]), _mm_packus_epi16(row0, row1));
+    }
+}
+
+#if _M_SSE >= 0x501
+
+// Same as the SSE2 version, with pixels 0-7 of the row in the low lane and 8-15 in the high lane.
+__ri void ipu_dither_avx2(const macroblock_rgb32 &rgb32, macroblock_rgb16 &rgb16, int dte)
+{
+    const __m256i alpha_test = _mm256_set1_epi16(0x40);
+    const __m256i dither_add_matrix[] = {
+        _mm256_setr_epi32(0x00000000, 0x00000000, 0x00000000, 0x00010101, 0x00000000, 0x00000000, 0x00000000, 0x00010101),
+        _mm256_setr_epi32(0x00020202, 0x00000000, 0x00030303, 0x00000000, 0x00020202, 0x00000000, 0x00030303, 0x00000000),
+        _mm256_setr_epi32(0x00000000, 0x00010101, 0x00000000, 0x00000000, 0x00000000, 0x00010101, 0x00000000, 0x00000000),
+        _mm256_setr_epi32(0x00030303, 0x00000000, 0x00020202, 0x00000000, 0x00030303, 0x00000000, 0x00020202, 0x00000000),
+    };
+    const __m256i dither_sub_matrix[] = {
+        _mm256_setr_epi32(0x00040404, 0x00000000, 0x00030303, 0x00000000, 0x00040404, 0x00000000, 0x00030303, 0x00000000),
+        _mm256_setr_epi32(0x00000000, 0x00020202, 0x00000000, 0x00010101, 0x00000000, 0x00020202, 0x00000000, 0x00010101),
+        _mm256_setr_epi32(0x00030303, 0x00000000, 0x00040404, 0x00000000, 0x00030303, 0x00000000, 0x00040404, 0x00000000),
+        _mm256_setr_epi32(0x00000000, 0x00010101, 0x00000000, 0x00020202, 0x00000000, 0x00010101, 0x00000000, 0x00020202),
+    };
+    for (int i = 0; i < 16; ++i) {
+        const __m256i rgba_8_01234567 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&rgb32.c[i][0]));
+        const __m256i rgba_8_89abcdef = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&rgb32.c[i][8]));
+        __m256i rgba_8_0123 = _mm256_permute2x128_si256(rgba_8_01234567, rgba_8_89abcdef, 0x20);
+        __m256i rgba_8_4567 = _mm256_permute2x128_si256(rgba_8_01234567, rgba_8_89abcdef, 0x31);
+
+        // Dither and clamp
+        if (dte) {
+            rgba_8_0123 = _mm256_subs_epu8(_mm256_adds_epu8(rgba_8_0123, dither_add_matrix[i & 3]), dither_sub_matrix[i & 3]);
+            rgba_8_4567 = _mm256_subs_epu8(_mm256_adds_epu8(rgba_8_4567, dither_add_matrix[i & 3]), dither_sub_matrix[i & 3]);
+        }
+
+        // Split into channel components and extend to 16 bits
+        const __m256i rgba_16_0415 = _mm256_unpacklo_epi8(rgba_8_0123, rgba_8_4567);
+        const __m256i rgba_16_2637 = _mm256_unpackhi_epi8(rgba_8_0123, rgba_8_4567);
+        const __m256i rgba_32_0246 = _mm256_unpacklo_epi8(rgba_16_0415, rgba_16_2637);
+        const __m256i rgba_32_1357 = _mm256_unpackhi_epi8(rgba_16_0415, rgba_16_2637);
+        const __m256i rg_64_01234567 = _mm256_unpacklo_epi8(rgba_32_0246, rgba_32_1357);
+        const __m256i ba_64_01234567 = _mm256_unpackhi_epi8(rgba_32_0246, rgba_32_1357);
+
+        const __m256i zero = _mm256_setzero_si256();
+        __m256i r = _mm256_unpacklo_epi8(rg_64_01234567, zero);
+        __m256i g = _mm256_unpackhi_epi8(rg_64_01234567, zero);
+        __m256i b = _mm256_unpacklo_epi8(ba_64_01234567, zero);
+        __m256i a = _mm256_unpackhi_epi8(ba_64_01234567, zero);
+
+        // Create RGBA
+        r = _mm256_srli_epi16(r, 3);
+        g = _mm256_slli_epi16(_mm256_srli_epi16(g, 3), 5);
+        b = _mm256_slli_epi16(_mm256_srli_epi16(b, 3), 10);
+        a = _mm256_slli_epi16(_mm256_cmpeq_epi16(a, alpha_test), 15);
+
+        const __m256i rgba16 = _mm256_or_si256(_mm256_or_si256(r, g), _mm256_or_si256(b, a));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(&rgb16.c[i][0]), rgba16);
+    }
+}
+
+// Same as the SSE4 version, a whole row at a time.
+__ri void ipu_vq_avx2(const macroblock_rgb16 &rgb16, u8 *indx4)
+{
+    const __m256i channel_mask = _mm256_set1_epi16(0x1f);
+    const __m256i index_mask = _mm256_set1_epi32(0xff);
+    const __m256i row_order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+    __m256i clut_r[16], clut_g[16], clut_b[16];
+    for (int k = 0; k < 16; ++k) {
+        clut_r[k] = _mm256_set1_epi16(g_ipu_vqclut[k].r);
+        clut_g[k] = _mm256_set1_epi16(g_ipu_vqclut[k].g);
+        clut_b[k] = _mm256_set1_epi16(g_ipu_vqclut[k].b);
+    }
+
+    const auto closest_index = [&](const __m256i rgba16) {
+        const __m256i r = _mm256_and_si256(rgba16, channel_mask);
+        const __m256i g = _mm256_and_si256(_mm256_srli_epi16(rgba16, 5), channel_mask);
+        const __m256i b = _mm256_and_si256(_mm256_srli_epi16(rgba16, 10), channel_mask);
+
+        __m256i index = _mm256_setzero_si256();
+        __m256i min_distance = _mm256_set1_epi16(0x7fff);
+        for (int k = 0; k < 16; ++k) {
+            const __m256i dr = _mm256_sub_epi16(r, clut_r[k]);
+            const __m256i dg = _mm256_sub_epi16(g, clut_g[k]);
+            const __m256i db = _mm256_sub_epi16(b, clut_b[k]);
+            const __m256i distance = _mm256_add_epi16(_mm256_add_epi16(_mm256_mullo_epi16(dr, dr), _mm256_mullo_epi16(dg, dg)), _mm256_mullo_epi16(db, db));
+
+            const __m256i closer = _mm256_cmpgt_epi16(min_distance, distance);
+            min_distance = _mm256_min_epi16(min_distance, distance);
+            index = _mm256_blendv_epi8(index, _mm256_set1_epi16(k), closer);
+        }
+
+        return _mm256_and_si256(_mm256_or_si256(index, _mm256_srli_epi32(index, 12)), index_mask);
+    };
+
+    for (int i = 0; i < 16; i += 2) {
+        const __m256i row0 = closest_index(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(&rgb16.c[i][0])));
+        const __m256i row1 = closest_index(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(&rgb16.c[i + 1][0])));
+
+        // Packing works within lanes, so put the four quarters of the two rows back in order afterwards.
+        const __m256i packed = _mm256_packus_epi16(_mm256_packs_epi32(row0, row1), _mm256_setzero_si256());
+        _mm_store_si128(reinterpret_cast<__m128i *>(&indx4[i * 8]), _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(packed, row_order)));
+    }
+}
+
+#endif
+
 #endif
 
 MULTI_ISA_UNSHARED_END
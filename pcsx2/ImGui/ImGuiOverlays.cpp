@@ -26,6 +26,7 @@
 #include "Patch.h"
 #include "PerformanceMetrics.h"
 #include "Recording/InputRecording.h"
+#include "Rewind.h"
 #include "SIO/Pad/Pad.h"
 #include "SIO/Pad/PadBase.h"
 #include "USB/USB.h"
@@ -69,6 +70,7 @@ SmallString s_cpu_usage_gs_line;
 SmallString s_cpu_usage_vu_line;
 std::vector<SmallString> s_software_thread_lines;
 SmallString s_capture_line;
+SmallString s_rewind_line;
 SmallString s_gpu_usage_line;
 SmallString s_gpu_debug_info_line;
 SmallString s_gpu_stats_line;
@@ -477,6 +479,9 @@ __ri void ImGuiManager::DrawPerformanceOverlay(float& position_y, float scale, f
 				{
 					s_cpu_usage_vu_line.assign("VU: ");
 					FormatProcessorStat(s_cpu_usage_vu_line, PerformanceMetrics::GetVUThreadUsage(), PerformanceMetrics::GetVUThreadAverageTime());
+					s_cpu_usage_vu_line.append_format(" | Wait EE: {:.2f}ms VU: {:.2f}ms ({:.1f}/batch)",
+						PerformanceMetrics::GetVUThreadEEWaitTime(), PerformanceMetrics::GetVUThreadIdleTime(),
+						PerformanceMetrics::GetVUThreadCommandsPerBatch());
 					DRAW_LINE(osd_font, font_size, s_cpu_usage_vu_line.c_str(), white_color);
 				}
 
@@ -495,8 +500,18 @@ __ri void ImGuiManager::DrawPerformanceOverlay(float& position_y, float scale, f
 				{
 					s_capture_line.assign("CAP: ");
 					FormatProcessorStat(s_capture_line, PerformanceMetrics::GetCaptureThreadUsage(), PerformanceMetrics::GetCaptureThreadAverageTime());
+					if (const u32 late = GSCapture::GetLateFrameCount(), dropped = GSCapture::GetDroppedFrameCount(); late > 0 || dropped > 0)
+						s_capture_line.append_format(" [{} late, {} dropped]", late, dropped);
 					DRAW_LINE(osd_font, font_size, s_capture_line.c_str(), white_color);
 				}
+
+				if (EmuConfig.Savestate.RewindEnable)
+				{
+					float average_ms, max_ms;
+					Rewind::GetCaptureTimes(&average_ms, &max_ms);
+					s_rewind_line.format("Rewind: {:.2f}ms avg, {:.2f}ms max", average_ms, max_ms);
+					DRAW_LINE(osd_font, font_size, s_rewind_line.c_str(), white_color);
+				}
 			}
 
 			if (GSConfig.OsdShowGPU)
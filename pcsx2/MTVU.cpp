@@ -7,6 +7,8 @@
 #include "VMManager.h"
 #include "Vif_Dynarec.h"
 
+#include "common/Timer.h"
+
 #include <thread>
 
 VU_Thread vu1Thread;
@@ -17,6 +19,13 @@ VU_Thread vu1Thread;
 // Rounds up a size in bytes for size in u32's
 static __fi u32 size_u32(u32 x) { return (x + 3) >> 2; }
 
+// Adds the time since start to a wait counter. Only called by the thread owning the counter.
+static __fi void AddWaitTime(std::atomic<u64>& counter, Common::Timer::Value start)
+{
+	counter.store(counter.load(std::memory_order_relaxed) + (Common::Timer::GetCurrentValue() - start),
+		std::memory_order_relaxed);
+}
+
 enum MTVU_EVENT
 {
 	MTVU_VU_EXECUTE,     // Execute VU program
@@ -96,6 +105,10 @@ void VU_Thread::Open()
 
 	Reset();
 	semaEvent.Reset();
+	m_ee_wait_ticks.store(0, std::memory_order_relaxed);
+	m_vu_idle_ticks.store(0, std::memory_order_relaxed);
+	m_commands.store(0, std::memory_order_relaxed);
+	m_batches.store(0, std::memory_order_relaxed);
 	m_shutdown_flag.store(false, std::memory_order_release);
 	m_thread.SetStackSize(VMManager::EMU_THREAD_STACK_SIZE);
 	m_thread.Start([this]() { ExecuteRingBuffer(); });
@@ -116,6 +129,7 @@ void VU_Thread::Reset()
 	vuCycleIdx = 0;
 	m_ato_write_pos = 0;
 	m_write_pos = 0;
+	m_batch_commands = 0;
 	m_ato_read_pos = 0;
 	m_read_pos = 0;
 	std::memset(&vif, 0, sizeof(vif));
@@ -131,7 +145,9 @@ void VU_Thread::ExecuteRingBuffer()
 
 	for (;;)
 	{
+		const Common::Timer::Value wait_start = Common::Timer::GetCurrentValue();
 		semaEvent.WaitForWork();
+		AddWaitTime(m_vu_idle_ticks, wait_start);
 		if (m_shutdown_flag.load(std::memory_order_acquire))
 			break;
 
@@ -211,6 +227,8 @@ void VU_Thread::ExecuteRingBuffer()
 // Should only be called by ReserveSpace()
 __ri void VU_Thread::WaitOnSize(s32 size)
 {
+	Common::Timer::Value wait_start = 0;
+
 	for (;;)
 	{
 		s32 readPos = GetReadPos();
@@ -224,6 +242,15 @@ __ri void VU_Thread::WaitOnSize(s32 size)
 		if (readPos > m_write_pos + size + _4kb)
 			break; // Enough free front space
 		{          // Let MTVU run to free up buffer space
+			if (wait_start == 0)
+			{
+				wait_start = Common::Timer::GetCurrentValue();
+
+				// Give the VU thread everything we have, so it isn't stuck on a partial batch.
+				if (m_batch_commands > 0)
+					CommitWritePos();
+			}
+
 			KickStart();
 			// Locking might trigger a full flush of the ring buffer. Yield
 			// will be more aggressive, and only flush the minimal size.
@@ -232,6 +259,9 @@ __ri void VU_Thread::WaitOnSize(s32 size)
 			std::this_thread::yield();
 		}
 	}
+
+	if (wait_start != 0)
+		AddWaitTime(m_ee_wait_ticks, wait_start);
 }
 
 // Makes sure theres enough room in the ring buffer
@@ -277,12 +307,30 @@ __fi void VU_Thread::CommitWritePos()
 {
 	m_ato_write_pos.store(m_write_pos, std::memory_order_release);
 
+	if (m_batch_commands > 0)
+	{
+		m_commands.store(m_commands.load(std::memory_order_relaxed) + m_batch_commands, std::memory_order_relaxed);
+		m_batches.store(m_batches.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		m_batch_commands = 0;
+	}
+
 	if (MTVU_ALWAYS_KICK)
 		KickStart();
 	if (MTVU_SYNC_MODE)
 		WaitVU();
 }
 
+// Adds the command which was just written to the current batch, committing the batch once it's full.
+__fi void VU_Thread::CommitCommand()
+{
+	m_batch_commands++;
+	if (m_batch_commands >= batch_commands ||
+		(m_write_pos - m_ato_write_pos.load(std::memory_order_relaxed)) >= batch_size)
+	{
+		Flush();
+	}
+}
+
 __fi void VU_Thread::CommitReadPos()
 {
 	m_ato_read_pos.store(m_read_pos, std::memory_order_release);
@@ -429,13 +477,36 @@ void VU_Thread::KickStart()
 
 bool VU_Thread::IsDone()
 {
-	return GetReadPos() == GetWritePos();
+	return m_batch_commands == 0 && GetReadPos() == GetWritePos();
+}
+
+void VU_Thread::Flush()
+{
+	if (m_batch_commands == 0)
+		return;
+
+	CommitWritePos();
+	KickStart();
 }
 
 void VU_Thread::WaitVU()
 {
 	MTVU_LOG("MTVU - WaitVU!");
+	Flush();
+
+	const Common::Timer::Value wait_start = Common::Timer::GetCurrentValue();
 	semaEvent.WaitForEmpty();
+	AddWaitTime(m_ee_wait_ticks, wait_start);
+}
+
+VU_Thread::Stats VU_Thread::GetStats() const
+{
+	Stats stats;
+	stats.ee_wait_ms = Common::Timer::ConvertValueToMilliseconds(m_ee_wait_ticks.load(std::memory_order_relaxed));
+	stats.vu_idle_ms = Common::Timer::ConvertValueToMilliseconds(m_vu_idle_ticks.load(std::memory_order_relaxed));
+	stats.commands = m_commands.load(std::memory_order_relaxed);
+	stats.batches = m_batches.load(std::memory_order_relaxed);
+	return stats;
 }
 
 void VU_Thread::ExecuteVU(u32 vu_addr, u32 vif_top, u32 vif_itop, u32 fbrst)
@@ -448,6 +519,7 @@ void VU_Thread::ExecuteVU(u32 vu_addr, u32 vif_top, u32 vif_itop, u32 fbrst)
 	Write(vif_top);
 	Write(vif_itop);
 	Write(fbrst);
+	m_batch_commands++; // The program needs everything queued before it, so always commit.
 	CommitWritePos();
 	gifUnit.TransferGSPacketData(GIF_TRANS_MTVU, NULL, 0);
 	KickStart();
@@ -474,8 +546,7 @@ void VU_Thread::VifUnpack(vifStruct& _vif, VIFregisters& _vifRegs, const u8* dat
 	WriteRegs(&_vifRegs);
 	Write(size);
 	Write(data, size);
-	CommitWritePos();
-	KickStart();
+	CommitCommand();
 }
 
 void VU_Thread::WriteMicroMem(u32 vu_micro_addr, const void* data, u32 size)
@@ -486,8 +557,7 @@ void VU_Thread::WriteMicroMem(u32 vu_micro_addr, const void* data, u32 size)
 	Write(vu_micro_addr);
 	Write(size);
 	Write(data, size);
-	CommitWritePos();
-	KickStart();
+	CommitCommand();
 }
 
 void VU_Thread::WriteDataMem(u32 vu_data_addr, const void* data, u32 size)
@@ -498,8 +568,7 @@ void VU_Thread::WriteDataMem(u32 vu_data_addr, const void* data, u32 size)
 	Write(vu_data_addr);
 	Write(size);
 	Write(data, size);
-	CommitWritePos();
-	KickStart();
+	CommitCommand();
 }
 
 void VU_Thread::WriteVIRegs(REG_VI* viRegs)
@@ -508,8 +577,7 @@ void VU_Thread::WriteVIRegs(REG_VI* viRegs)
 	ReserveSpace(1 + size_u32(32));
 	Write(MTVU_VU_WRITE_VIREGS);
 	Write(viRegs, size_u32(32));
-	CommitWritePos();
-	KickStart();
+	CommitCommand();
 }
 
 void VU_Thread::WriteVFRegs(VECTOR* vfRegs)
@@ -518,8 +586,7 @@ void VU_Thread::WriteVFRegs(VECTOR* vfRegs)
 	ReserveSpace(1 + size_u32(32*4));
 	Write(MTVU_VU_WRITE_VFREGS);
 	Write(vfRegs, size_u32(32*4));
-	CommitWritePos();
-	KickStart();
+	CommitCommand();
 }
 
 void VU_Thread::WriteCol(vifStruct& _vif)
@@ -528,8 +595,7 @@ void VU_Thread::WriteCol(vifStruct& _vif)
 	ReserveSpace(1 + size_u32(sizeof(_vif.MaskCol)));
 	Write(MTVU_VIF_WRITE_COL);
 	Write(&_vif.MaskCol, sizeof(_vif.MaskCol));
-	CommitWritePos();
-	KickStart();
+	CommitCommand();
 }
 
 void VU_Thread::WriteRow(vifStruct& _vif)
@@ -538,6 +604,5 @@ void VU_Thread::WriteRow(vifStruct& _vif)
 	ReserveSpace(1 + size_u32(sizeof(_vif.MaskRow)));
 	Write(MTVU_VIF_WRITE_ROW);
 	Write(&_vif.MaskRow, sizeof(_vif.MaskRow));
-	CommitWritePos();
-	KickStart();
+	CommitCommand();
 }
@@ -16,21 +16,43 @@
 // - This class should only be accessed from the EE thread...
 // - buffer_size must be power of 2
 // - ring-buffer has no complete pending packets when read_pos==write_pos
+// - Commands other than ExecuteVU are batched, and only made visible to the VU thread
+//   once the batch is full, an ExecuteVU is queued, or the EE thread waits on the VU thread.
 class VU_Thread final {
 	static const s32 buffer_size = (_1mb * 16) / sizeof(s32);
 
+	// Limits for a batch of commands, in u32's and commands.
+	// Kept small enough that the VU thread can start on large unpacks while the EE thread is still queueing.
+	static const s32 batch_size = _32kb / sizeof(s32);
+	static const u32 batch_commands = 32;
+
 	u32 buffer[buffer_size];
 	// Note: keep atomic on separate cache line to avoid CPU conflict
 	alignas(__cachelinesize) std::atomic<int> m_ato_read_pos; // Only modified by VU thread
 	alignas(__cachelinesize) std::atomic<int> m_ato_write_pos;    // Only modified by EE thread
 	alignas(__cachelinesize) int  m_read_pos; // temporary read pos (local to the VU thread)
 	int  m_write_pos; // temporary write pos (local to the EE thread)
+	u32  m_batch_commands; // commands written since the last commit (local to the EE thread)
 	Threading::WorkSema semaEvent;
 	std::atomic_bool m_shutdown_flag{false};
 
 	Threading::Thread m_thread;
 
+	// Wait instrumentation, in timer ticks. Written by the owning thread, read by the performance metrics.
+	std::atomic<u64> m_ee_wait_ticks{0}; // EE thread waiting for ring space, or for the VU thread to finish
+	std::atomic<u64> m_vu_idle_ticks{0}; // VU thread waiting for work
+	std::atomic<u64> m_commands{0};
+	std::atomic<u64> m_batches{0};
+
 public:
+	struct Stats
+	{
+		double ee_wait_ms;
+		double vu_idle_ms;
+		u64 commands;
+		u64 batches;
+	};
+
 	alignas(16)  vifStruct        vif;
 	alignas(16)  VIFregisters     vifRegs;
 	Threading::UserspaceSemaphore semaXGkick;
@@ -95,6 +117,12 @@ public:
 
 	void WriteRow(vifStruct& _vif);
 
+	// Makes any batched commands visible to the VU thread.
+	void Flush();
+
+	// Returns the total wait times and command counts since the thread was opened.
+	Stats GetStats() const;
+
 private:
 	void ExecuteRingBuffer();
 
@@ -107,6 +135,7 @@ private:
 	u32* GetWritePtr();
 
 	void CommitWritePos();
+	void CommitCommand();
 	void CommitReadPos();
 
 	u32 Read();
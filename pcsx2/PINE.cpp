@@ -13,8 +13,12 @@
 #include "common/Threading.h"
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <mutex>
 #include <span>
 #include <sys/types.h>
 #include <thread>
@@ -159,6 +163,11 @@ namespace PINEServer
 		MsgUUID = 0xD, /**< Returns the game UUID. */
 		MsgGameVersion = 0xE, /**< Returns the game verion. */
 		MsgStatus = 0xF, /**< Returns the emulator status. */
+		MsgReadRange = 0x10, /**< Read a range of memory. */
+		MsgWriteRange = 0x11, /**< Write a range of memory. */
+		MsgReadBatch = 0x12, /**< Read a list of memory ranges. */
+		MsgSetWatch = 0x13, /**< Sets the memory ranges captured every vsync. */
+		MsgWaitWatch = 0x14, /**< Waits for the next vsync capture of the watched ranges. */
 		MsgUnimplemented = 0xFF /**< Unimplemented IPC message. */
 	};
 
@@ -195,6 +204,37 @@ namespace PINEServer
 		IPC_FAIL = 0xFF /**< IPC command failed to complete. */
 	};
 
+	/**
+	 * Memory range captured every vsync.
+	 */
+	struct WatchRange
+	{
+		u32 address;
+		u32 size;
+	};
+
+	/**
+	 * Maximum number of ranges in a batch read or watch list.
+	 */
+	static constexpr u32 MAX_IPC_RANGES = MAX_IPC_SIZE / 8;
+
+	/**
+	 * Longest a MsgWaitWatch will block for, so a paused VM doesn't hang the client forever.
+	 */
+	static constexpr std::chrono::milliseconds WATCH_WAIT_TIMEOUT{1000};
+
+	// Watched ranges and their latest capture. Captured on the CPU thread, so a frame is never torn.
+	static std::mutex s_watch_mutex;
+	static std::condition_variable s_watch_cv;
+	static std::vector<WatchRange> s_watch_ranges;
+	static std::vector<u8> s_watch_data;
+	static u32 s_watch_frame = 0;
+	static u32 s_watch_seen_frame = 0;
+	static std::atomic_bool s_watch_active{false};
+
+	static void SetWatch(std::vector<WatchRange> ranges, u32 total_size);
+	static void ClearWatch();
+
 	// Thread used to relay IPC commands.
 	void MainLoop();
 	void ClientLoop();
@@ -422,6 +462,7 @@ void PINEServer::MainLoop()
 			continue;
 
 		ClientLoop();
+		ClearWatch();
 
 		Console.WriteLn("PINE: Client disconnected.");
 		safe_close_portable(s_msgsock);
@@ -480,9 +521,44 @@ void PINEServer::ClientLoop()
 	}
 }
 
+void PINEServer::SetWatch(std::vector<WatchRange> ranges, u32 total_size)
+{
+	std::unique_lock lock(s_watch_mutex);
+	s_watch_ranges = std::move(ranges);
+	s_watch_data.assign(total_size, 0);
+	s_watch_seen_frame = s_watch_frame;
+	s_watch_active.store(!s_watch_ranges.empty(), std::memory_order_release);
+}
+
+void PINEServer::ClearWatch()
+{
+	SetWatch({}, 0);
+}
+
+void PINEServer::OnVSync()
+{
+	if (!s_watch_active.load(std::memory_order_acquire))
+		return;
+
+	std::unique_lock lock(s_watch_mutex);
+	u8* ptr = s_watch_data.data();
+	for (const WatchRange& range : s_watch_ranges)
+	{
+		// Ranges touching hardware registers read as zero, like a failed read would.
+		if (!vtlb_memSafeReadBytes(range.address, ptr, range.size))
+			std::memset(ptr, 0, range.size);
+		ptr += range.size;
+	}
+
+	s_watch_frame++;
+	lock.unlock();
+	s_watch_cv.notify_one();
+}
+
 void PINEServer::Deinitialize()
 {
 	s_end.store(true, std::memory_order_release);
+	s_watch_cv.notify_all();
 
 #ifndef _WIN32
 	if (!s_socket_name.empty())
@@ -746,6 +822,117 @@ PINEServer::IPCBuffer PINEServer::ParseCommand(std::span<u8> buf, std::vector<u8
 				ret_cnt += 4;
 				break;
 			}
+			case MsgReadRange:
+			{
+				if (!VMManager::HasValidVM())
+					goto error;
+				if (!SafetyChecks(buf_cnt, 8, ret_cnt, 0, buf_size)) [[unlikely]]
+					goto error;
+				const u32 a = FromSpan<u32>(buf, buf_cnt);
+				const u32 size = FromSpan<u32>(buf, buf_cnt + 4);
+				if (size >= MAX_IPC_RETURN_SIZE || !SafetyChecks(buf_cnt, 8, ret_cnt, size, buf_size)) [[unlikely]]
+					goto error;
+				if (!vtlb_memSafeReadBytes(a, ret_buffer.data() + ret_cnt, size))
+					goto error;
+				ret_cnt += size;
+				buf_cnt += 8;
+				break;
+			}
+			case MsgWriteRange:
+			{
+				if (!VMManager::HasValidVM())
+					goto error;
+				if (!SafetyChecks(buf_cnt, 8, ret_cnt, 0, buf_size)) [[unlikely]]
+					goto error;
+				const u32 a = FromSpan<u32>(buf, buf_cnt);
+				const u32 size = FromSpan<u32>(buf, buf_cnt + 4);
+				if (size >= MAX_IPC_SIZE || !SafetyChecks(buf_cnt, 8 + size, ret_cnt, 0, buf_size)) [[unlikely]]
+					goto error;
+				if (!vtlb_memSafeWriteBytes(a, buf.data() + buf_cnt + 8, size))
+					goto error;
+				buf_cnt += 8 + size;
+				break;
+			}
+			case MsgReadBatch:
+			{
+				// format: XX NN NN NN NN [YY YY YY YY SS SS SS SS] * N
+				// reply:  XX [data of each range, back to back]
+				if (!VMManager::HasValidVM())
+					goto error;
+				if (!SafetyChecks(buf_cnt, 4, ret_cnt, 0, buf_size)) [[unlikely]]
+					goto error;
+				const u32 count = FromSpan<u32>(buf, buf_cnt);
+				if (count > MAX_IPC_RANGES || !SafetyChecks(buf_cnt, 4 + count * 8, ret_cnt, 0, buf_size)) [[unlikely]]
+					goto error;
+				buf_cnt += 4;
+				for (u32 i = 0; i < count; i++)
+				{
+					const u32 a = FromSpan<u32>(buf, buf_cnt);
+					const u32 size = FromSpan<u32>(buf, buf_cnt + 4);
+					if (size >= MAX_IPC_RETURN_SIZE || !SafetyChecks(buf_cnt, 8, ret_cnt, size, buf_size)) [[unlikely]]
+						goto error;
+					if (!vtlb_memSafeReadBytes(a, ret_buffer.data() + ret_cnt, size))
+						goto error;
+					ret_cnt += size;
+					buf_cnt += 8;
+				}
+				break;
+			}
+			case MsgSetWatch:
+			{
+				// format: XX NN NN NN NN [YY YY YY YY SS SS SS SS] * N, an empty list stops watching
+				if (!SafetyChecks(buf_cnt, 4, ret_cnt, 0, buf_size)) [[unlikely]]
+					goto error;
+				const u32 count = FromSpan<u32>(buf, buf_cnt);
+				if (count > MAX_IPC_RANGES || !SafetyChecks(buf_cnt, 4 + count * 8, ret_cnt, 0, buf_size)) [[unlikely]]
+					goto error;
+				buf_cnt += 4;
+
+				std::vector<WatchRange> ranges(count);
+				u32 total_size = 0;
+				for (WatchRange& range : ranges)
+				{
+					range.address = FromSpan<u32>(buf, buf_cnt);
+					range.size = FromSpan<u32>(buf, buf_cnt + 4);
+					buf_cnt += 8;
+
+					// the whole capture has to fit in a single MsgWaitWatch reply
+					if (range.size >= MAX_IPC_RETURN_SIZE || (total_size += range.size) >= MAX_IPC_RETURN_SIZE) [[unlikely]]
+						goto error;
+				}
+
+				SetWatch(std::move(ranges), total_size);
+				break;
+			}
+			case MsgWaitWatch:
+			{
+				// reply: XX FF FF FF FF [data of each watched range, back to back]
+				// FF is the capture counter, so clients can tell if they missed a frame.
+				if (!VMManager::HasValidVM())
+					goto error;
+
+				std::unique_lock lock(s_watch_mutex);
+				if (s_watch_ranges.empty() ||
+					!SafetyChecks(buf_cnt, 0, ret_cnt, 4 + static_cast<int>(s_watch_data.size()), buf_size)) [[unlikely]]
+				{
+					goto error;
+				}
+
+				if (!s_watch_cv.wait_for(lock, WATCH_WAIT_TIMEOUT, []() {
+						return (s_watch_frame != s_watch_seen_frame || s_end.load(std::memory_order_acquire));
+					}) ||
+					s_end.load(std::memory_order_acquire))
+				{
+					goto error;
+				}
+
+				s_watch_seen_frame = s_watch_frame;
+				ToResultVector(ret_buffer, s_watch_frame, ret_cnt);
+				ret_cnt += 4;
+				std::memcpy(ret_buffer.data() + ret_cnt, s_watch_data.data(), s_watch_data.size());
+				ret_cnt += static_cast<u32>(s_watch_data.size());
+				break;
+			}
 			default:
 			{
 			error:
@@ -19,4 +19,7 @@ namespace PINEServer
 
 	bool Initialize(int slot = PINE_DEFAULT_SLOT);
 	void Deinitialize();
+
+	// Captures the memory ranges a client is watching, called on the CPU thread every vsync.
+	void OnVSync();
 } // namespace PINEServer
@@ -1681,6 +1681,12 @@ void Pcsx2Config::SavestateOptions::LoadSave(SettingsWrapper& wrap)
 
 	SettingsWrapIntEnumEx(CompressionType, "SavestateCompressionType");
 	SettingsWrapIntEnumEx(CompressionRatio, "SavestateCompressionRatio");
+	SettingsWrapEntryEx(RewindEnable, "SavestateRewindEnable");
+	SettingsWrapEntryEx(RewindFrequency, "SavestateRewindFrequency");
+	SettingsWrapEntryEx(RewindBufferSize, "SavestateRewindBufferSize");
+
+	RewindFrequency = std::max(RewindFrequency, 1u);
+	RewindBufferSize = std::clamp(RewindBufferSize, 16u, 4096u);
 }
 
 bool Pcsx2Config::SavestateOptions::operator!=(const SavestateOptions& right) const
@@ -1690,7 +1696,8 @@ bool Pcsx2Config::SavestateOptions::operator!=(const SavestateOptions& right) co
 
 bool Pcsx2Config::SavestateOptions::operator==(const SavestateOptions& right) const
 {
-	return OpEqu(CompressionType) && OpEqu(CompressionRatio);
+	return OpEqu(CompressionType) && OpEqu(CompressionRatio) && OpEqu(RewindEnable) && OpEqu(RewindFrequency) &&
+		   OpEqu(RewindBufferSize);
 };
 
 Pcsx2Config::FilenameOptions::FilenameOptions()
@@ -1965,6 +1972,7 @@ Pcsx2Config::Pcsx2Config()
 	}
 
 	GzipIsoIndexTemplate = "$(f).pindex.tmp";
+	CdvdReadaheadBuffers = 2;
 	PINESlot = 28011;
 	RtcYear = 0;
 	RtcMonth = 1;
@@ -2021,6 +2029,7 @@ void Pcsx2Config::LoadSaveCore(SettingsWrapper& wrap)
 	Achievements.LoadSave(wrap);
 
 	SettingsWrapEntry(GzipIsoIndexTemplate);
+	SettingsWrapEntry(CdvdReadaheadBuffers);
 	SettingsWrapEntry(PINESlot);
 	SettingsWrapEntry(RtcYear);
 	SettingsWrapEntry(RtcMonth);
@@ -51,6 +51,10 @@ static float s_gs_thread_usage = 0.0f;
 static float s_gs_thread_time = 0.0f;
 static float s_vu_thread_usage = 0.0f;
 static float s_vu_thread_time = 0.0f;
+static float s_vu_ee_wait_time = 0.0f;
+static float s_vu_idle_time = 0.0f;
+static float s_vu_commands_per_batch = 0.0f;
+static VU_Thread::Stats s_last_vu_stats = {};
 static float s_capture_thread_usage = 0.0f;
 static float s_capture_thread_time = 0.0f;
 
@@ -92,6 +96,9 @@ void PerformanceMetrics::Clear()
 	s_gs_thread_time = 0.0f;
 	s_vu_thread_usage = 0.0f;
 	s_vu_thread_time = 0.0f;
+	s_vu_ee_wait_time = 0.0f;
+	s_vu_idle_time = 0.0f;
+	s_vu_commands_per_batch = 0.0f;
 	s_capture_thread_usage = 0.0f;
 	s_capture_thread_time = 0.0f;
 
@@ -123,6 +130,7 @@ void PerformanceMetrics::Reset()
 	s_last_cpu_time = s_cpu_thread_handle.GetCPUTime();
 	s_last_gs_time = MTGS::GetThreadHandle().GetCPUTime();
 	s_last_vu_time = THREAD_VU1 ? vu1Thread.GetThreadHandle().GetCPUTime() : 0;
+	s_last_vu_stats = vu1Thread.GetStats();
 	s_last_ticks = GetCPUTicks();
 	s_last_capture_time = GSCapture::IsCapturing() ? GSCapture::GetEncoderThreadHandle().GetCPUTime() : 0;
 
@@ -220,6 +228,17 @@ void PerformanceMetrics::Update(bool gs_register_write, bool fb_blit, bool is_sk
 	s_vu_thread_time = static_cast<double>(vu_delta) * time_divider;
 	s_capture_thread_time = static_cast<double>(capture_delta) * time_divider;
 
+	const VU_Thread::Stats vu_stats = vu1Thread.GetStats();
+	if (vu_stats.batches < s_last_vu_stats.batches)
+		s_last_vu_stats = {}; // VU thread was restarted
+	const u64 vu_batches = vu_stats.batches - s_last_vu_stats.batches;
+	s_vu_ee_wait_time = static_cast<float>((vu_stats.ee_wait_ms - s_last_vu_stats.ee_wait_ms) / s_frames_since_last_update);
+	s_vu_idle_time = static_cast<float>((vu_stats.vu_idle_ms - s_last_vu_stats.vu_idle_ms) / s_frames_since_last_update);
+	s_vu_commands_per_batch = (vu_batches > 0) ?
+		static_cast<float>(static_cast<double>(vu_stats.commands - s_last_vu_stats.commands) / static_cast<double>(vu_batches)) :
+		0.0f;
+	s_last_vu_stats = vu_stats;
+
 	for (GSSWThreadStats& thread : s_gs_sw_threads)
 	{
 		const u64 time = thread.handle.GetCPUTime();
@@ -337,6 +356,21 @@ float PerformanceMetrics::GetVUThreadAverageTime()
 	return s_vu_thread_time;
 }
 
+float PerformanceMetrics::GetVUThreadEEWaitTime()
+{
+	return s_vu_ee_wait_time;
+}
+
+float PerformanceMetrics::GetVUThreadIdleTime()
+{
+	return s_vu_idle_time;
+}
+
+float PerformanceMetrics::GetVUThreadCommandsPerBatch()
+{
+	return s_vu_commands_per_batch;
+}
+
 float PerformanceMetrics::GetCaptureThreadUsage()
 {
 	return s_capture_thread_usage;
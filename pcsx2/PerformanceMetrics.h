@@ -48,6 +48,12 @@ namespace PerformanceMetrics
 	float GetGSThreadAverageTime();
 	float GetVUThreadUsage();
 	float GetVUThreadAverageTime();
+
+	/// Per-frame time the EE thread spent waiting on the VU thread, and the VU thread spent waiting for work.
+	float GetVUThreadEEWaitTime();
+	float GetVUThreadIdleTime();
+	float GetVUThreadCommandsPerBatch();
+
 	float GetCaptureThreadUsage();
 	float GetCaptureThreadAverageTime();
 
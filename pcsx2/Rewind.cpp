@@ -0,0 +1,464 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "Config.h"
+#include "GSDumpReplayer.h"
+#include "Host.h"
+#include "MTVU.h"
+#include "R5900.h"
+#include "Rewind.h"
+#include "SaveState.h"
+
+#include "common/Console.h"
+#include "common/Error.h"
+#include "common/Threading.h"
+#include "common/Timer.h"
+
+#include "lz4.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace Rewind
+{
+	static constexpr u32 DELTA_PAGE_SIZE = 4096;
+	static constexpr u32 STATS_LOG_INTERVAL = 300;
+
+	struct Snapshot
+	{
+		std::vector<ArchiveEntry> entries;
+		u32 size;
+
+		/// XOR of this state against the newer one, as a list of
+		/// [u32 page index][u32 stored size][page data, LZ4 compressed unless stored size == page size].
+		std::vector<u8> delta;
+	};
+
+	static u32 GetUsedSize(const ArchiveEntryList& list);
+	static u32 GetPageLength(u32 page, u32 size);
+	static void EncodeDelta(const u8* older, u32 older_size, const u8* newer, u32 newer_size, std::vector<u8>* delta);
+	static bool ApplyDelta(u8* buffer, u32 buffer_size, const Snapshot& snapshot);
+	static void CaptureState();
+	static void EncodeThread();
+	static void EncodeCapture(u32 capture_size);
+	static u64 GetWorkingBuffersSize();
+	static void EnforceBudget();
+	static void WaitForEncode();
+	static void StopEncodeThread();
+	static void ReleaseBuffers();
+
+	static ArchiveEntryList s_state_lists[2];
+
+	/// Newest captured state, stored whole.
+	static ArchiveEntryList* s_current = &s_state_lists[0];
+	static u32 s_current_size = 0;
+
+	/// Scratch list which new states are captured into, swapped with s_current once encoded.
+	static ArchiveEntryList* s_capture = &s_state_lists[1];
+
+	/// Older states, oldest first.
+	static std::deque<Snapshot> s_history;
+	static u64 s_history_size = 0;
+
+	/// Deltas are computed off the CPU thread, and waited on before the buffers are touched again.
+	static std::thread s_encode_thread;
+	static std::mutex s_encode_mutex;
+	static std::condition_variable s_encode_cv;
+	static std::condition_variable s_encode_done_cv;
+	static u32 s_encode_capture_size = 0;
+	static bool s_encode_pending = false;
+	static bool s_encode_shutdown = false;
+
+	static u32 s_frames_since_capture = 0;
+
+	/// Set at vsync, and captured once the CPU has left execution, the same as a normal save.
+	static bool s_capture_pending = false;
+
+	static u64 s_stat_captures = 0;
+	static u64 s_stat_delta_bytes = 0;
+	static double s_stat_capture_time = 0.0;
+	static double s_stat_max_capture_time = 0.0;
+
+	/// Copies of the capture timings, for the performance overlay on the GS thread.
+	static std::atomic<float> s_stat_average_capture_ms{0.0f};
+	static std::atomic<float> s_stat_max_capture_ms{0.0f};
+} // namespace Rewind
+
+u32 Rewind::GetUsedSize(const ArchiveEntryList& list)
+{
+	u32 size = 0;
+	for (size_t i = 0; i < list.GetLength(); i++)
+	{
+		const ArchiveEntry& entry = list[static_cast<uint>(i)];
+		size = std::max(size, static_cast<u32>(entry.GetDataIndex() + entry.GetDataSize()));
+	}
+
+	return size;
+}
+
+u32 Rewind::GetPageLength(u32 page, u32 size)
+{
+	return std::min(DELTA_PAGE_SIZE, size - page * DELTA_PAGE_SIZE);
+}
+
+void Rewind::EncodeDelta(const u8* older, u32 older_size, const u8* newer, u32 newer_size, std::vector<u8>* delta)
+{
+	// Bytes past the end of either state are treated as zero.
+	const u32 size = std::max(older_size, newer_size);
+	const u32 num_pages = (size + DELTA_PAGE_SIZE - 1) / DELTA_PAGE_SIZE;
+
+	alignas(16) u8 xor_page[DELTA_PAGE_SIZE];
+	char compressed[LZ4_COMPRESSBOUND(DELTA_PAGE_SIZE)];
+
+	delta->clear();
+
+	for (u32 page = 0; page < num_pages; page++)
+	{
+		const u32 offset = page * DELTA_PAGE_SIZE;
+		const u32 length = GetPageLength(page, size);
+
+		// Fast path for the common case, an unchanged page present in both states.
+		if ((offset + length) <= older_size && (offset + length) <= newer_size &&
+			std::memcmp(older + offset, newer + offset, length) == 0)
+		{
+			continue;
+		}
+
+		bool changed = false;
+		for (u32 i = 0; i < length; i++)
+		{
+			const u8 o = (offset + i < older_size) ? older[offset + i] : 0;
+			const u8 n = (offset + i < newer_size) ? newer[offset + i] : 0;
+			xor_page[i] = o ^ n;
+			changed |= (xor_page[i] != 0);
+		}
+		if (!changed)
+			continue;
+
+		const int compressed_size = LZ4_compress_default(reinterpret_cast<const char*>(xor_page), compressed,
+			static_cast<int>(length), static_cast<int>(sizeof(compressed)));
+		const bool store_raw = (compressed_size <= 0 || static_cast<u32>(compressed_size) >= length);
+		const u32 stored_size = store_raw ? length : static_cast<u32>(compressed_size);
+
+		const size_t pos = delta->size();
+		delta->resize(pos + sizeof(u32) * 2 + stored_size);
+		std::memcpy(delta->data() + pos, &page, sizeof(u32));
+		std::memcpy(delta->data() + pos + sizeof(u32), &stored_size, sizeof(u32));
+		std::memcpy(delta->data() + pos + sizeof(u32) * 2, store_raw ? static_cast<const void*>(xor_page) : compressed, stored_size);
+	}
+
+	delta->shrink_to_fit();
+}
+
+bool Rewind::ApplyDelta(u8* buffer, u32 buffer_size, const Snapshot& snapshot)
+{
+	// Anything past the end of the newer state was zero in the older one, unless the delta says otherwise.
+	if (snapshot.size > buffer_size)
+		std::memset(buffer + buffer_size, 0, snapshot.size - buffer_size);
+
+	const u32 size = std::max(snapshot.size, buffer_size);
+	alignas(16) u8 xor_page[DELTA_PAGE_SIZE];
+
+	const u8* ptr = snapshot.delta.data();
+	const u8* const end = ptr + snapshot.delta.size();
+	while (ptr < end)
+	{
+		u32 page, stored_size;
+		std::memcpy(&page, ptr, sizeof(u32));
+		std::memcpy(&stored_size, ptr + sizeof(u32), sizeof(u32));
+		ptr += sizeof(u32) * 2;
+
+		const u32 offset = page * DELTA_PAGE_SIZE;
+		if (offset >= size || ptr + stored_size > end)
+			return false;
+
+		const u32 length = GetPageLength(page, size);
+		if (stored_size == length)
+		{
+			std::memcpy(xor_page, ptr, length);
+		}
+		else if (LZ4_decompress_safe(reinterpret_cast<const char*>(ptr), reinterpret_cast<char*>(xor_page),
+					 static_cast<int>(stored_size), static_cast<int>(length)) != static_cast<int>(length))
+		{
+			return false;
+		}
+
+		ptr += stored_size;
+
+		// Bytes past the end of the newer state have already been zeroed above.
+		for (u32 i = 0; i < length; i++)
+			buffer[offset + i] ^= xor_page[i];
+	}
+
+	return true;
+}
+
+void Rewind::WaitForEncode()
+{
+	std::unique_lock lock(s_encode_mutex);
+	s_encode_done_cv.wait(lock, []() { return !s_encode_pending; });
+}
+
+void Rewind::StopEncodeThread()
+{
+	if (!s_encode_thread.joinable())
+		return;
+
+	{
+		std::unique_lock lock(s_encode_mutex);
+		s_encode_shutdown = true;
+		s_encode_cv.notify_one();
+	}
+
+	s_encode_thread.join();
+	s_encode_shutdown = false;
+}
+
+void Rewind::EncodeThread()
+{
+	Threading::SetNameOfCurrentThread("Rewind Encode");
+
+	std::unique_lock lock(s_encode_mutex);
+	for (;;)
+	{
+		s_encode_cv.wait(lock, []() { return s_encode_pending || s_encode_shutdown; });
+
+		// Finish any outstanding capture before leaving, so the buffers are consistent.
+		if (s_encode_pending)
+		{
+			const u32 capture_size = s_encode_capture_size;
+			lock.unlock();
+			EncodeCapture(capture_size);
+			lock.lock();
+
+			s_encode_pending = false;
+			s_encode_done_cv.notify_all();
+		}
+		else if (s_encode_shutdown)
+		{
+			break;
+		}
+	}
+}
+
+void Rewind::OnVSync()
+{
+	if (!EmuConfig.Savestate.RewindEnable || GSDumpReplayer::IsReplayingDump())
+		return;
+
+	if (++s_frames_since_capture < std::max(EmuConfig.Savestate.RewindFrequency, 1u))
+		return;
+
+	s_frames_since_capture = 0;
+
+	// Partway through the vsync event, the counters and interrupts haven't been updated yet.
+	s_capture_pending = true;
+	Cpu->ExitExecution();
+}
+
+void Rewind::ProcessPendingCapture()
+{
+	if (!std::exchange(s_capture_pending, false))
+		return;
+
+	CaptureState();
+}
+
+void Rewind::CaptureState()
+{
+	WaitForEncode();
+
+	// Same as a normal save, VU1 has to be idle for its state to be consistent.
+	if (THREAD_VU1)
+		vu1Thread.WaitVU();
+
+	const Common::Timer timer;
+
+	Error error;
+	if (!SaveState_DownloadState(s_capture, &error))
+	{
+		ERROR_LOG("Rewind: Failed to capture state: {}", error.GetDescription());
+		return;
+	}
+
+	const u32 capture_size = GetUsedSize(*s_capture);
+
+	const double capture_time = timer.GetTimeMilliseconds();
+	s_stat_captures++;
+	s_stat_capture_time += capture_time;
+	s_stat_max_capture_time = std::max(s_stat_max_capture_time, capture_time);
+	s_stat_average_capture_ms.store(static_cast<float>(s_stat_capture_time / static_cast<double>(s_stat_captures)),
+		std::memory_order_relaxed);
+	s_stat_max_capture_ms.store(static_cast<float>(s_stat_max_capture_time), std::memory_order_relaxed);
+
+	if ((s_stat_captures % STATS_LOG_INTERVAL) == 0)
+	{
+		const Stats stats = GetStats();
+		DEV_LOG("Rewind: {} states using {:.1f}MB, capture {:.2f}ms avg {:.2f}ms max, {:.1f}KB per delta",
+			stats.snapshots, static_cast<double>(stats.memory_used) / 1048576.0, stats.average_capture_ms,
+			stats.max_capture_ms, stats.average_delta_kb);
+	}
+
+	// Comparing and compressing the pages takes longer than the capture itself, so keep it off the CPU thread.
+	if (!s_encode_thread.joinable())
+		s_encode_thread = std::thread(&Rewind::EncodeThread);
+
+	std::unique_lock lock(s_encode_mutex);
+	s_encode_capture_size = capture_size;
+	s_encode_pending = true;
+	s_encode_cv.notify_one();
+}
+
+void Rewind::EncodeCapture(u32 capture_size)
+{
+	if (s_current_size > 0)
+	{
+		Snapshot snapshot;
+		snapshot.size = s_current_size;
+		snapshot.entries.reserve(s_current->GetLength());
+		for (size_t i = 0; i < s_current->GetLength(); i++)
+			snapshot.entries.push_back((*s_current)[static_cast<uint>(i)]);
+
+		EncodeDelta(s_current->GetPtr(0), s_current_size, s_capture->GetPtr(0), capture_size, &snapshot.delta);
+
+		s_stat_delta_bytes += snapshot.delta.size();
+		s_history_size += snapshot.delta.size();
+		s_history.push_back(std::move(snapshot));
+	}
+
+	std::swap(s_current, s_capture);
+	s_current_size = capture_size;
+
+	EnforceBudget();
+}
+
+u64 Rewind::GetWorkingBuffersSize()
+{
+	// The capture buffer holds a whole state as well, so it counts towards the budget too.
+	return s_current->GetBuffer().size() + s_capture->GetBuffer().size();
+}
+
+void Rewind::EnforceBudget()
+{
+	const u64 budget = static_cast<u64>(EmuConfig.Savestate.RewindBufferSize) * _1mb;
+	while (!s_history.empty() && (GetWorkingBuffersSize() + s_history_size) > budget)
+	{
+		s_history_size -= s_history.front().delta.size();
+		s_history.pop_front();
+	}
+}
+
+void Rewind::Reset()
+{
+	WaitForEncode();
+
+	s_history.clear();
+	s_history_size = 0;
+	s_current->Clear();
+	s_current_size = 0;
+	s_frames_since_capture = 0;
+	s_capture_pending = false;
+
+	// Don't hold on to the capture buffers if rewind has been turned off.
+	if (!EmuConfig.Savestate.RewindEnable)
+	{
+		StopEncodeThread();
+		ReleaseBuffers();
+	}
+}
+
+void Rewind::ReleaseBuffers()
+{
+	SaveStateBase::VmStateBuffer().swap(s_current->GetBuffer());
+	SaveStateBase::VmStateBuffer().swap(s_capture->GetBuffer());
+	s_capture->Clear();
+}
+
+void Rewind::Shutdown()
+{
+	Reset();
+	StopEncodeThread();
+	ReleaseBuffers();
+
+	s_stat_captures = 0;
+	s_stat_delta_bytes = 0;
+	s_stat_capture_time = 0.0;
+	s_stat_max_capture_time = 0.0;
+	s_stat_average_capture_ms.store(0.0f, std::memory_order_relaxed);
+	s_stat_max_capture_ms.store(0.0f, std::memory_order_relaxed);
+}
+
+bool Rewind::CanStepBack()
+{
+	WaitForEncode();
+	return !s_history.empty();
+}
+
+bool Rewind::StepBack(Error* error)
+{
+	WaitForEncode();
+
+	if (s_history.empty())
+	{
+		Error::SetString(error, TRANSLATE_STR("Rewind", "No earlier states are available to rewind to."));
+		return false;
+	}
+
+	const Snapshot& snapshot = s_history.back();
+	if (s_current->GetBuffer().size() < snapshot.size)
+		s_current->GetBuffer().resize(snapshot.size);
+
+	if (!ApplyDelta(s_current->GetPtr(0), s_current_size, snapshot))
+	{
+		Error::SetString(error, "Rewind buffer is corrupted.");
+		Reset();
+		return false;
+	}
+
+	s_current->Clear();
+	for (const ArchiveEntry& entry : snapshot.entries)
+		s_current->Add(entry);
+	s_current_size = snapshot.size;
+
+	s_history_size -= snapshot.delta.size();
+	s_history.pop_back();
+
+	// Don't capture again immediately, otherwise holding rewind would never get anywhere.
+	s_frames_since_capture = 0;
+
+	if (!SaveState_LoadFromMemory(*s_current, error))
+	{
+		Reset();
+		return false;
+	}
+
+	return true;
+}
+
+Rewind::Stats Rewind::GetStats()
+{
+	Stats stats = {};
+	stats.snapshots = static_cast<u32>(s_history.size()) + ((s_current_size > 0) ? 1 : 0);
+	stats.memory_used = GetWorkingBuffersSize() + s_history_size;
+	stats.captures = s_stat_captures;
+	if (s_stat_captures > 0)
+	{
+		stats.average_capture_ms = s_stat_capture_time / static_cast<double>(s_stat_captures);
+		stats.max_capture_ms = s_stat_max_capture_time;
+		stats.average_delta_kb = static_cast<double>(s_stat_delta_bytes) / 1024.0 / static_cast<double>(s_stat_captures);
+	}
+
+	return stats;
+}
+
+void Rewind::GetCaptureTimes(float* average_ms, float* max_ms)
+{
+	*average_ms = s_stat_average_capture_ms.load(std::memory_order_relaxed);
+	*max_ms = s_stat_max_capture_ms.load(std::memory_order_relaxed);
+}
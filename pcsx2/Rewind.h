@@ -0,0 +1,49 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#pragma once
+
+#include "common/Pcsx2Defs.h"
+
+class Error;
+
+/// Keeps a bounded history of save states in memory, so the VM can be stepped backwards.
+/// Only the newest state is kept whole, older states are stored as compressed deltas
+/// against the state which followed them, containing only the pages which changed.
+namespace Rewind
+{
+	struct Stats
+	{
+		u32 snapshots;
+		u64 memory_used;
+		u64 captures;
+		double average_capture_ms;
+		double max_capture_ms;
+		double average_delta_kb;
+	};
+
+	/// Called on the CPU thread at vsync, requests a capture and leaves execution when one is due.
+	void OnVSync();
+
+	/// Called on the CPU thread after leaving execution, captures the state requested at vsync.
+	void ProcessPendingCapture();
+
+	/// Drops all captured states, e.g. after loading a save state or changing settings.
+	void Reset();
+
+	/// Releases all memory used by the rewind buffer.
+	void Shutdown();
+
+	/// Returns true if there is at least one state to rewind to.
+	bool CanStepBack();
+
+	/// Restores the state captured before the most recent one.
+	bool StepBack(Error* error);
+
+	/// Returns capture timing and memory usage, for measuring the per-frame cost.
+	/// Memory usage includes both full state buffers, as well as the deltas.
+	Stats GetStats();
+
+	/// Returns the average and worst time the CPU thread spent capturing a state. Can be called from any thread.
+	void GetCaptureTimes(float* average_ms, float* max_ms);
+} // namespace Rewind
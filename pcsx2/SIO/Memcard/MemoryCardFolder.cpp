@@ -16,6 +16,7 @@
 #include "common/FileSystem.h"
 #include "common/Path.h"
 #include "common/StringUtil.h"
+#include "common/Threading.h"
 #include "common/Timer.h"
 #include "common/YAML.h"
 
@@ -23,6 +24,7 @@
 
 #include <optional>
 #include <chrono>
+#include <functional>
 
 // A helper function to parse the YAML file
 static std::optional<ryml::Tree> loadYamlFile(const char* filePath)
@@ -53,13 +55,25 @@ static std::optional<ryml::Tree> loadYamlFile(const char* filePath)
 	return tree;
 }
 
+// Host files are replaced by renaming, so an interrupted flush never leaves a truncated one behind.
+static bool CommitFile(const char* filename, const std::function<bool(std::FILE*)>& write)
+{
+	if (!FileSystem::WriteAtomicRenamedFile(filename, write))
+	{
+		Console.Error("FolderMcd: Failed to write '%s'.", filename);
+		return false;
+	}
+
+	return true;
+}
+
 /// A helper function to write a YAML file
 static void SaveYAMLToFile(const char* filename, const ryml::NodeRef& node)
 {
-	auto file = FileSystem::OpenCFile(filename, "w");
-	ryml::emit_yaml(node, file);
-	std::fflush(file);
-	std::fclose(file);
+	CommitFile(filename, [&node](std::FILE* file) {
+		ryml::emit_yaml(node, file);
+		return true;
+	});
 }
 
 static auto last = std::chrono::time_point<std::chrono::system_clock>();
@@ -107,10 +121,17 @@ FolderMemoryCard::FolderMemoryCard()
 	, m_slot(0)
 	, m_isEnabled(false)
 	, m_performFileWrites(false)
+	, m_flushPending(false)
+	, m_flushShutdown(false)
 	, m_filteringEnabled(false)
 {
 }
 
+FolderMemoryCard::~FolderMemoryCard()
+{
+	StopFlushThread();
+}
+
 void FolderMemoryCard::InitializeInternalData()
 {
 	memset(&m_superBlock, 0xFF, sizeof(m_superBlock));
@@ -143,6 +164,7 @@ void FolderMemoryCard::Open(const bool enableFiltering, std::string filter)
 
 void FolderMemoryCard::Open(std::string fullPath, const Pcsx2Config::McdOptions& mcdOptions, const u32 sizeInClusters, const bool enableFiltering, std::string filter, bool simulateFileWrites)
 {
+	WaitForFlush();
 	InitializeInternalData();
 	m_performFileWrites = !simulateFileWrites;
 
@@ -195,6 +217,8 @@ void FolderMemoryCard::Open(std::string fullPath, const Pcsx2Config::McdOptions&
 
 void FolderMemoryCard::Close(bool flush)
 {
+	WaitForFlush();
+
 	if (!m_isEnabled)
 	{
 		return;
@@ -705,8 +729,10 @@ s32 FolderMemoryCard::IsPresent() const
 	return m_isEnabled;
 }
 
-void FolderMemoryCard::GetSizeInfo(McdSizeInfo& outways) const
+void FolderMemoryCard::GetSizeInfo(McdSizeInfo& outways)
 {
+	WaitForFlush();
+
 	outways.SectorSize = PageSize;
 	outways.EraseBlockSizeInSectors = BlockSize / PageSize;
 	outways.McdSizeInSectors = GetSizeInClusters() * 2;
@@ -935,6 +961,8 @@ bool FolderMemoryCard::ReadFromFile(u8* dest, u32 adr, u32 dataLength)
 
 s32 FolderMemoryCard::Read(u8* dest, u32 adr, int size)
 {
+	WaitForFlush();
+
 	//const u32 block = adr / BlockSizeRaw;
 	const u32 page = adr / PageSizeRaw;
 	const u32 offset = adr % PageSizeRaw;
@@ -1014,6 +1042,8 @@ void FolderMemoryCard::ReadDataWithoutCache(u8* const dest, const u32 adr, const
 
 s32 FolderMemoryCard::Save(const u8* src, u32 adr, int size)
 {
+	WaitForFlush();
+
 	//const u32 block = adr / BlockSizeRaw;
 	//const u32 cluster = adr / ClusterSizeRaw;
 	const u32 page = adr / PageSizeRaw;
@@ -1062,8 +1092,70 @@ void FolderMemoryCard::NextFrame()
 {
 	if (m_framesUntilFlush > 0 && --m_framesUntilFlush == 0)
 	{
+		// Rewriting the host files can take a long time on big cards, so keep it off the CPU thread.
+		// The card is idle at this point, any access before the flush finishes will wait for it.
+		WaitForFlush();
+
+		// The thread is started with the lock held, so it can't run a flush before m_flushThread is set.
+		std::unique_lock lock(m_flushMutex);
+		if (!m_flushThread.joinable())
+		{
+			m_flushShutdown = false;
+			m_flushThread = std::thread(&FolderMemoryCard::FlushThreadEntryPoint, this);
+		}
+
+		m_flushPending = true;
+		m_flushCV.notify_all();
+	}
+}
+
+void FolderMemoryCard::FlushThreadEntryPoint()
+{
+	Threading::SetNameOfCurrentThread("Folder Memcard Flush");
+
+	std::unique_lock lock(m_flushMutex);
+	for (;;)
+	{
+		m_flushCV.wait(lock, [this]() { return m_flushPending || m_flushShutdown; });
+		if (m_flushShutdown)
+			break;
+
+		lock.unlock();
 		Flush();
+		lock.lock();
+
+		m_flushPending = false;
+		m_flushCV.notify_all();
+	}
+}
+
+void FolderMemoryCard::WaitForFlush()
+{
+	// Flush() calls back into Save() for multi-page writes, which must not wait on itself.
+	if (!m_flushThread.joinable() || m_flushThread.get_id() == std::this_thread::get_id())
+	{
+		return;
+	}
+
+	std::unique_lock lock(m_flushMutex);
+	m_flushCV.wait(lock, [this]() { return !m_flushPending; });
+}
+
+void FolderMemoryCard::StopFlushThread()
+{
+	WaitForFlush();
+	if (!m_flushThread.joinable())
+	{
+		return;
+	}
+
+	{
+		std::unique_lock lock(m_flushMutex);
+		m_flushShutdown = true;
+		m_flushCV.notify_all();
 	}
+
+	m_flushThread.join();
 }
 
 void FolderMemoryCard::Flush()
@@ -1198,10 +1290,9 @@ void FolderMemoryCard::FlushSuperBlock()
 	if (FlushBlock(0) && m_performFileWrites)
 	{
 		const std::string superBlockFileName(Path::Combine(m_folderName, "_pcsx2_superblock"));
-		if (auto superBlockFile = FileSystem::OpenManagedCFile(superBlockFileName.c_str(), "wb"); superBlockFile)
-		{
-			std::fwrite(&m_superBlock.raw, sizeof(m_superBlock.raw), 1, superBlockFile.get());
-		}
+		CommitFile(superBlockFileName.c_str(), [this](std::FILE* file) {
+			return std::fwrite(&m_superBlock.raw, sizeof(m_superBlock.raw), 1, file) == 1;
+		});
 	}
 }
 
@@ -1209,18 +1300,18 @@ void FolderMemoryCard::FlushFileEntries()
 {
 	// Flush all file entry data from the cache into m_fileEntryDict.
 	const u32 rootDirCluster = m_superBlock.data.rootdir_cluster;
-	FlushCluster(rootDirCluster + m_superBlock.data.alloc_offset);
+	const bool rootFlushed = FlushCluster(rootDirCluster + m_superBlock.data.alloc_offset);
 	MemoryCardFileEntryCluster* rootEntries = &m_fileEntryDict[rootDirCluster];
 	if (rootEntries->entries[0].IsValid() && rootEntries->entries[0].IsUsed())
 	{
-		FlushFileEntries(rootDirCluster, rootEntries->entries[0].entry.data.length);
+		FlushFileEntries(rootDirCluster, rootEntries->entries[0].entry.data.length, {}, nullptr, rootFlushed);
 	}
 }
 
-void FolderMemoryCard::FlushFileEntries(const u32 dirCluster, const u32 remainingFiles, const std::string& dirPath, MemoryCardFileMetadataReference* parent)
+void FolderMemoryCard::FlushFileEntries(const u32 dirCluster, const u32 remainingFiles, const std::string& dirPath, MemoryCardFileMetadataReference* parent, const bool clusterFlushed)
 {
-	// flush the current cluster
-	FlushCluster(dirCluster + m_superBlock.data.alloc_offset);
+	// flush the current cluster, if nothing in it changed then neither did the host metadata of its entries
+	const bool entriesChanged = FlushCluster(dirCluster + m_superBlock.data.alloc_offset) || clusterFlushed;
 
 	// if either of the current entries is a subdir, flush that too
 	MemoryCardFileEntryCluster* entries = &m_fileEntryDict[dirCluster];
@@ -1239,7 +1330,7 @@ void FolderMemoryCard::FlushFileEntries(const u32 dirCluster, const u32 remainin
 					bool filenameCleaned = FileAccessHelper::CleanMemcardFilename(cleanName);
 					const std::string subDirPath(Path::Combine(dirPath, cleanName));
 
-					if (m_performFileWrites)
+					if (m_performFileWrites && entriesChanged)
 					{
 						// if this directory has nonstandard metadata, write that to the file system
 						const std::string fullSubDirPath(Path::Combine(m_folderName, subDirPath));
@@ -1252,10 +1343,9 @@ void FolderMemoryCard::FlushFileEntries(const u32 dirCluster, const u32 remainin
 						// TODO: This logic doesn't make sense. If it's not a directory, create it, then open it as a file?!
 						if (filenameCleaned || entry->entry.data.mode != MemoryCardFileEntry::DefaultDirMode || entry->entry.data.attr != 0)
 						{
-							if (auto metaFile = FileSystem::OpenManagedCFile(metaFileName.c_str(), "wb"); metaFile)
-							{
-								std::fwrite(entry->entry.raw, sizeof(entry->entry.raw), 1, metaFile.get());
-							}
+							CommitFile(metaFileName.c_str(), [entry](std::FILE* file) {
+								return std::fwrite(entry->entry.raw, sizeof(entry->entry.raw), 1, file) == 1;
+							});
 						}
 						else
 						{
@@ -1326,7 +1416,7 @@ void FolderMemoryCard::FlushFileEntries(const u32 dirCluster, const u32 remainin
 				if (entry->entry.data.length == 0)
 				{
 					// empty files need to be explicitly created, as there will be no data cluster referencing it later
-					if (m_performFileWrites)
+					if (m_performFileWrites && entriesChanged)
 					{
 						char cleanName[sizeof(entry->entry.data.name)];
 						memcpy(cleanName, (const char*)entry->entry.data.name, sizeof(cleanName));
@@ -1341,12 +1431,12 @@ void FolderMemoryCard::FlushFileEntries(const u32 dirCluster, const u32 remainin
 								FileSystem::CreateDirectoryPath(fullDirPath.c_str(), false);
 							}
 
-							auto createEmptyFile = FileSystem::OpenManagedCFile(fn.c_str(), "wb");
+							CommitFile(fn.c_str(), [](std::FILE*) { return true; });
 						}
 					}
 				}
 
-				if (m_performFileWrites)
+				if (m_performFileWrites && entriesChanged)
 				{
 					FileAccessHelper::WriteIndex(m_folderName, entry, parent);
 				}
@@ -3,9 +3,12 @@
 
 #pragma once
 
+#include <condition_variable>
 #include <map>
+#include <mutex>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <vector>
 
 #include "Config.h"
@@ -290,6 +293,14 @@ protected:
 	// remembers and keeps the last accessed file open for further access
 	FileAccessHelper m_lastAccessedFile;
 
+	// flushes triggered by NextFrame() run on this thread, everything else waits for it via WaitForFlush()
+	// started by the first such flush and kept until the card is destroyed
+	std::thread m_flushThread;
+	std::mutex m_flushMutex;
+	std::condition_variable m_flushCV;
+	bool m_flushPending;
+	bool m_flushShutdown;
+
 	// path to the folder that contains the files of this memory card
 	std::string m_folderName;
 
@@ -307,7 +318,7 @@ protected:
 
 public:
 	FolderMemoryCard();
-	virtual ~FolderMemoryCard() = default;
+	virtual ~FolderMemoryCard();
 
 	void Lock();
 	void Unlock();
@@ -327,7 +338,7 @@ public:
 	bool ReIndex(bool enableFiltering, const std::string& filter);
 
 	s32 IsPresent() const;
-	void GetSizeInfo(McdSizeInfo& outways) const;
+	void GetSizeInfo(McdSizeInfo& outways);
 	bool IsPSX() const;
 	s32 Read(u8* dest, u32 adr, int size);
 	s32 Save(const u8* src, u32 adr, int size);
@@ -469,6 +480,15 @@ protected:
 	// flush the whole cache to the internal data and/or host file system
 	void Flush();
 
+	// blocks until a background flush started by NextFrame() has finished
+	void WaitForFlush();
+
+	// runs the flushes started by NextFrame() until StopFlushThread() is called
+	void FlushThreadEntryPoint();
+
+	// waits for any background flush and shuts down the flush thread
+	void StopFlushThread();
+
 	// flush a single page of the cache to the internal data and/or host file system
 	bool FlushPage(const u32 page);
 
@@ -485,7 +505,9 @@ protected:
 	void FlushFileEntries();
 
 	// flush a directory's file entries and all its subdirectories to the internal data
-	void FlushFileEntries(const u32 dirCluster, const u32 remainingFiles, const std::string& dirPath = {}, MemoryCardFileMetadataReference* parent = nullptr);
+	// host metadata and indexes are only rewritten for entries in clusters which were modified since the last flush
+	// - clusterFlushed: set if the caller already flushed dirCluster from the cache
+	void FlushFileEntries(const u32 dirCluster, const u32 remainingFiles, const std::string& dirPath = {}, MemoryCardFileMetadataReference* parent = nullptr, const bool clusterFlushed = false);
 
 	// "delete" (prepend '_pcsx2_deleted_' to) any files that exist in oldFileEntries but no longer exist in m_fileEntryDict
 	// also calls RemoveUnchangedDataFromCache() since both operate on comparing with the old file entires
@@ -36,13 +36,16 @@
 #include "common/Path.h"
 #include "common/ScopedGuard.h"
 #include "common/StringUtil.h"
+#include "common/Threading.h"
 #include "common/ZipHelpers.h"
 
 #include "IconsFontAwesome.h"
 #include "fmt/format.h"
 
+#include <atomic>
 #include <csetjmp>
 #include <png.h>
+#include <thread>
 
 using namespace R5900;
 
@@ -170,12 +173,15 @@ bool SaveStateBase::FreezeBios()
 	return IsOkay();
 }
 
-bool SaveStateBase::FreezeInternals(Error* error)
+static void WarnIfMTVUEnabled()
 {
 	// Print this until the MTVU problem in gifPathFreeze is taken care of (rama)
 	if (THREAD_VU1)
 		Console.Warning("MTVU speedhack is enabled, saved states may not be stable");
+}
 
+bool SaveStateBase::FreezeInternals(Error* error)
+{
 	if (!vmFreeze())
 		return false;
 
@@ -357,9 +363,63 @@ static int SysState_MTGSFreeze(FreezeAction mode, freezeData* fP)
 static constexpr SysState_Component SPU2_{ "SPU2", SPU2freeze };
 static constexpr SysState_Component GS{ "GS", SysState_MTGSFreeze };
 
-static bool SysState_ComponentFreezeIn(zip_file_t* zf, SysState_Component comp)
+namespace
 {
-	if (!zf)
+	/// Decompresses a zip entry on the fly, rather than reading it into a temporary buffer first.
+	/// Only supports seeking forwards, which is all StateWrapper needs when reading.
+	class ZipReadStream final : public StateWrapper::IStream
+	{
+	public:
+		explicit ZipReadStream(zip_file_t* zf)
+			: m_zf(zf)
+		{
+		}
+
+		u32 Read(void* buf, u32 count) override
+		{
+			const zip_int64_t read = zip_fread(m_zf, buf, count);
+			if (read <= 0)
+				return 0;
+
+			m_position += static_cast<u32>(read);
+			return static_cast<u32>(read);
+		}
+
+		u32 Write(const void* buf, u32 count) override { return 0; }
+		u32 GetPosition() override { return m_position; }
+
+		bool SeekAbsolute(u32 pos) override
+		{
+			return (pos >= m_position && Skip(pos - m_position));
+		}
+
+		bool SeekRelative(s32 count) override
+		{
+			return (count >= 0 && Skip(static_cast<u32>(count)));
+		}
+
+	private:
+		bool Skip(u32 count)
+		{
+			u8 discard[4096];
+			while (count > 0)
+			{
+				const u32 size = std::min<u32>(count, sizeof(discard));
+				if (Read(discard, size) != size)
+					return false;
+				count -= size;
+			}
+			return true;
+		}
+
+		zip_file_t* m_zf;
+		u32 m_position = 0;
+	};
+} // namespace
+
+static bool SysState_ComponentFreezeIn(StateWrapper::IStream* stream, SysState_Component comp)
+{
+	if (!stream)
 		return true;
 
 	freezeData fP = { 0, nullptr };
@@ -374,7 +434,7 @@ static bool SysState_ComponentFreezeIn(zip_file_t* zf, SysState_Component comp)
 		data = std::make_unique<u8[]>(fP.size);
 		fP.data = data.get();
 
-		if (zip_fread(zf, data.get(), fP.size) != static_cast<zip_int64_t>(fP.size))
+		if (stream->Read(data.get(), fP.size) != static_cast<u32>(fP.size))
 		{
 			Console.Error(fmt::format("* {}: Failed to decompress save data", comp.name));
 			return false;
@@ -418,20 +478,10 @@ static bool SysState_ComponentFreezeOut(SaveStateBase& writer, SysState_Componen
 	return true;
 }
 
-static bool SysState_ComponentFreezeInNew(zip_file_t* zf, const char* name, bool(*do_state_func)(StateWrapper&))
+static bool SysState_ComponentFreezeInNew(StateWrapper::IStream* stream, const char* name, bool(*do_state_func)(StateWrapper&))
 {
-	// TODO: We could decompress on the fly here for a little bit more speed.
-	std::vector<u8> data;
-	if (zf)
-	{
-		std::optional<std::vector<u8>> optdata(ReadBinaryFileInZip(zf));
-		if (optdata.has_value())
-			data = std::move(optdata.value());
-	}
-
-	StateWrapper::ReadOnlyMemoryStream stream(data.empty() ? nullptr : data.data(), data.size());
-	StateWrapper sw(&stream, StateWrapper::Mode::Read, g_SaveVersion);
-
+	StateWrapper::ReadOnlyMemoryStream empty_stream(nullptr, 0);
+	StateWrapper sw(stream ? stream : &empty_stream, StateWrapper::Mode::Read, g_SaveVersion);
 	return do_state_func(sw);
 }
 
@@ -466,9 +516,12 @@ public:
 	virtual ~BaseSavestateEntry() = default;
 
 	virtual const char* GetFilename() const = 0;
-	virtual bool FreezeIn(zip_file_t* zf) const = 0;
+	virtual bool FreezeIn(StateWrapper::IStream* stream) const = 0;
 	virtual bool FreezeOut(SaveStateBase& writer) const = 0;
 	virtual bool IsRequired() const = 0;
+
+	/// Entries which only copy into guest memory can be decompressed concurrently with the others.
+	virtual bool CanLoadInParallel() const { return false; }
 };
 
 class MemorySavestateEntry : public BaseSavestateEntry
@@ -478,20 +531,21 @@ protected:
 	virtual ~MemorySavestateEntry() = default;
 
 public:
-	virtual bool FreezeIn(zip_file_t* zf) const;
+	virtual bool FreezeIn(StateWrapper::IStream* stream) const;
 	virtual bool FreezeOut(SaveStateBase& writer) const;
 	virtual bool IsRequired() const { return true; }
+	bool CanLoadInParallel() const override { return true; }
 
 protected:
 	virtual u8* GetDataPtr() const = 0;
 	virtual u32 GetDataSize() const = 0;
 };
 
-bool MemorySavestateEntry::FreezeIn(zip_file_t* zf) const
+bool MemorySavestateEntry::FreezeIn(StateWrapper::IStream* stream) const
 {
 	const u32 expectedSize = GetDataSize();
-	const s64 bytesRead = zip_fread(zf, GetDataPtr(), expectedSize);
-	if (bytesRead != static_cast<s64>(expectedSize))
+	const u32 bytesRead = stream->Read(GetDataPtr(), expectedSize);
+	if (bytesRead != expectedSize)
 	{
 		Console.WriteLn(Color_Yellow, " '%s' is incomplete (expected 0x%x bytes, loading only 0x%x bytes)",
 			GetFilename(), expectedSize, static_cast<u32>(bytesRead));
@@ -524,9 +578,9 @@ public:
 	u8* GetDataPtr() const override { return eeMem->Main; }
 	uint GetDataSize() const override { return Ps2MemSize::ExposedRam; }
 
-	virtual bool FreezeIn(zip_file_t* zf) const override
+	virtual bool FreezeIn(StateWrapper::IStream* stream) const override
 	{
-		return MemorySavestateEntry::FreezeIn(zf);
+		return MemorySavestateEntry::FreezeIn(stream);
 	}
 };
 
@@ -616,7 +670,7 @@ public:
 	~SavestateEntry_SPU2() override = default;
 
 	const char* GetFilename() const override { return "SPU2.bin"; }
-	bool FreezeIn(zip_file_t* zf) const override { return SysState_ComponentFreezeIn(zf, SPU2_); }
+	bool FreezeIn(StateWrapper::IStream* stream) const override { return SysState_ComponentFreezeIn(stream, SPU2_); }
 	bool FreezeOut(SaveStateBase& writer) const override { return SysState_ComponentFreezeOut(writer, SPU2_); }
 	bool IsRequired() const override { return true; }
 };
@@ -627,7 +681,7 @@ public:
 	~SavestateEntry_USB() override = default;
 
 	const char* GetFilename() const override { return "USB.bin"; }
-	bool FreezeIn(zip_file_t* zf) const override { return SysState_ComponentFreezeInNew(zf, "USB", &USB::DoState); }
+	bool FreezeIn(StateWrapper::IStream* stream) const override { return SysState_ComponentFreezeInNew(stream, "USB", &USB::DoState); }
 	bool FreezeOut(SaveStateBase& writer) const override { return SysState_ComponentFreezeOutNew(writer, "USB", 16 * 1024, &USB::DoState); }
 	bool IsRequired() const override { return false; }
 };
@@ -638,7 +692,7 @@ public:
 	~SavestateEntry_PAD() override = default;
 
 	const char* GetFilename() const override { return "PAD.bin"; }
-	bool FreezeIn(zip_file_t* zf) const override { return SysState_ComponentFreezeInNew(zf, "PAD", &Pad::Freeze); }
+	bool FreezeIn(StateWrapper::IStream* stream) const override { return SysState_ComponentFreezeInNew(stream, "PAD", &Pad::Freeze); }
 	bool FreezeOut(SaveStateBase& writer) const override { return SysState_ComponentFreezeOutNew(writer, "PAD", 16 * 1024, &Pad::Freeze); }
 	bool IsRequired() const override { return true; }
 };
@@ -649,7 +703,7 @@ public:
 	~SavestateEntry_GS() = default;
 
 	const char* GetFilename() const { return "GS.bin"; }
-	bool FreezeIn(zip_file_t* zf) const { return SysState_ComponentFreezeIn(zf, GS); }
+	bool FreezeIn(StateWrapper::IStream* stream) const { return SysState_ComponentFreezeIn(stream, GS); }
 	bool FreezeOut(SaveStateBase& writer) const { return SysState_ComponentFreezeOut(writer, GS); }
 	bool IsRequired() const { return true; }
 };
@@ -659,19 +713,21 @@ class SaveStateEntry_Achievements final : public BaseSavestateEntry
 	~SaveStateEntry_Achievements() override = default;
 
 	const char* GetFilename() const override { return "Achievements.bin"; }
-	bool FreezeIn(zip_file_t* zf) const override
+	bool FreezeIn(StateWrapper::IStream* stream) const override
 	{
 		if (!Achievements::IsActive())
 			return true;
 
-		std::optional<std::vector<u8>> data;
-		if (zf)
-			data = ReadBinaryFileInZip(zf);
+		std::vector<u8> data;
+		if (stream)
+		{
+			u8 chunk[4096];
+			u32 read;
+			while ((read = stream->Read(chunk, sizeof(chunk))) > 0)
+				data.insert(data.end(), chunk, chunk + read);
+		}
 
-		if (data.has_value())
-			Achievements::LoadState(data.value());
-		else
-			Achievements::LoadState(std::span<const u8>());
+		Achievements::LoadState(data);
 
 		return true;
 	}
@@ -712,8 +768,22 @@ static const std::unique_ptr<BaseSavestateEntry> SavestateEntries[] = {
 
 std::unique_ptr<ArchiveEntryList> SaveState_DownloadState(Error* error)
 {
+	// Not for the in-memory captures below, rewind would print this every few frames.
+	WarnIfMTVUEnabled();
+
 	std::unique_ptr<ArchiveEntryList> destlist = std::make_unique<ArchiveEntryList>();
-	destlist->GetBuffer().resize(1024 * 1024 * 64);
+	if (!SaveState_DownloadState(destlist.get(), error))
+		destlist.reset();
+
+	return destlist;
+}
+
+bool SaveState_DownloadState(ArchiveEntryList* destlist, Error* error)
+{
+	// Buffers are reused when capturing repeatedly, only allocate the first time.
+	destlist->Clear();
+	if (destlist->GetBuffer().size() < 1024 * 1024 * 64)
+		destlist->GetBuffer().resize(1024 * 1024 * 64);
 
 	memSavingState saveme(destlist->GetBuffer());
 	ArchiveEntry internals(EntryFilename_InternalStructures);
@@ -722,7 +792,7 @@ std::unique_ptr<ArchiveEntryList> SaveState_DownloadState(Error* error)
 	if (!saveme.FreezeBios())
 	{
 		Error::SetString(error, "FreezeBios() failed");
-		return nullptr;
+		return false;
 	}
 
 	if (!saveme.FreezeInternals(error))
@@ -730,7 +800,7 @@ std::unique_ptr<ArchiveEntryList> SaveState_DownloadState(Error* error)
 		if (!error->IsValid())
 			Error::SetString(error, "FreezeInternals() failed");
 
-		return nullptr;
+		return false;
 	}
 
 	internals.SetDataSize(saveme.GetCurrentPos() - internals.GetDataIndex());
@@ -742,8 +812,7 @@ std::unique_ptr<ArchiveEntryList> SaveState_DownloadState(Error* error)
 		if (!entry->FreezeOut(saveme))
 		{
 			Error::SetString(error, fmt::format("FreezeOut() failed for {}.", entry->GetFilename()));
-			destlist.reset();
-			break;
+			return false;
 		}
 
 		destlist->Add(
@@ -752,7 +821,7 @@ std::unique_ptr<ArchiveEntryList> SaveState_DownloadState(Error* error)
 				.SetDataSize(saveme.GetCurrentPos() - startpos));
 	}
 
-	return destlist;
+	return true;
 }
 
 std::unique_ptr<SaveStateScreenshotData> SaveState_SaveScreenshot()
@@ -1137,6 +1206,69 @@ static zip_int64_t CheckFileExistsInState(zip_t* zf, const char* name, bool requ
 	return index;
 }
 
+// Locates the internal structures and each component with find(name, required), which returns -1 if it's
+// missing. Shared by loading from a zip and from memory.
+template <typename FindFunc>
+static bool FindStateEntries(const FindFunc& find, s64* internal_index, s64* entry_indices, Error* error)
+{
+	*internal_index = find(EntryFilename_InternalStructures, true);
+
+	// Log any parts and pieces that are missing, and then generate an exception.
+	bool allPresent = (*internal_index >= 0);
+	for (u32 i = 0; i < std::size(SavestateEntries); i++)
+	{
+		const bool required = SavestateEntries[i]->IsRequired();
+		entry_indices[i] = find(SavestateEntries[i]->GetFilename(), required);
+		if (entry_indices[i] < 0 && required)
+		{
+			allPresent = false;
+			break;
+		}
+	}
+	if (!allPresent)
+	{
+		Error::SetString(error, "Some required components were not found or are incomplete.");
+		return false;
+	}
+
+	return true;
+}
+
+// Loads each component with load(i, index), or resets it if it's missing. Returns the name of the
+// component which failed, if any. Components which can load in parallel are skipped if requested.
+template <typename LoadFunc>
+static const char* LoadStateEntries(const s64* entry_indices, bool skip_parallel, const LoadFunc& load)
+{
+	for (u32 i = 0; i < std::size(SavestateEntries); ++i)
+	{
+		if (skip_parallel && SavestateEntries[i]->CanLoadInParallel() && entry_indices[i] >= 0)
+			continue;
+
+		if (entry_indices[i] < 0)
+		{
+			SavestateEntries[i]->FreezeIn(nullptr);
+			continue;
+		}
+
+		if (!load(i, entry_indices[i]))
+			return SavestateEntries[i]->GetFilename();
+	}
+
+	return nullptr;
+}
+
+static bool LoadInternalStructuresState(const SaveStateBase::VmStateBuffer& buffer, Error* error)
+{
+	memLoadingState state(buffer);
+	if (!state.FreezeBios())
+		return false;
+
+	if (!state.FreezeInternals(error))
+		return false;
+
+	return true;
+}
+
 static bool LoadInternalStructuresState(zip_t* zf, s64 index, Error* error)
 {
 	zip_stat_t zst;
@@ -1152,14 +1284,7 @@ static bool LoadInternalStructuresState(zip_t* zf, s64 index, Error* error)
 	if (zip_fread(zff.get(), buffer.data(), buffer.size()) != static_cast<zip_int64_t>(buffer.size()))
 		return false;
 
-	memLoadingState state(buffer);
-	if (!state.FreezeBios())
-		return false;
-	
-	if (!state.FreezeInternals(error))
-		return false;
-
-	return true;
+	return LoadInternalStructuresState(buffer, error);
 }
 
 bool SaveState_UnzipFromDisk(const std::string& filename, Error* error)
@@ -1182,30 +1307,111 @@ bool SaveState_UnzipFromDisk(const std::string& filename, Error* error)
 		return false;
 
 	// check that all parts are included
-	const s64 internal_index = CheckFileExistsInState(zf.get(), EntryFilename_InternalStructures, true);
+	s64 internal_index;
 	s64 entryIndices[std::size(SavestateEntries)];
+	if (!FindStateEntries([&zf](const char* name, bool required) { return CheckFileExistsInState(zf.get(), name, required); },
+			&internal_index, entryIndices, error))
+	{
+		return false;
+	}
 
-	// Log any parts and pieces that are missing, and then generate an exception.
-	bool allPresent = (internal_index >= 0);
-	for (u32 i = 0; i < std::size(SavestateEntries); i++)
+	WarnIfMTVUEnabled();
+	PreLoadPrep();
+
+	if (!LoadInternalStructuresState(zf.get(), internal_index, error))
 	{
-		const bool required = SavestateEntries[i]->IsRequired();
-		entryIndices[i] = CheckFileExistsInState(zf.get(), SavestateEntries[i]->GetFilename(), required);
-		if (entryIndices[i] < 0 && required)
+		if (!error->IsValid())
+			Error::SetString(error, "Save state corruption in internal structures.");
+
+		VMManager::Reset();
+		return false;
+	}
+
+	// Guest memory makes up most of the state, so decompress it on a second thread, with its own
+	// handle to the archive (libzip handles can't be shared), while we load everything else.
+	std::atomic<const char*> parallel_failed_entry{nullptr};
+	std::thread parallel_thread([&filename, &entryIndices, &parallel_failed_entry]() {
+		Threading::SetNameOfCurrentThread("Savestate Load");
+
+		zip_error_t pze = {};
+		auto pzf = zip_open_managed(filename.c_str(), ZIP_RDONLY, &pze);
+		for (u32 i = 0; i < std::size(SavestateEntries); ++i)
 		{
-			allPresent = false;
-			break;
+			if (!SavestateEntries[i]->CanLoadInParallel() || entryIndices[i] < 0)
+				continue;
+
+			if (!pzf)
+			{
+				Console.Error("Failed to reopen zip file '%s' for save state load: %s", filename.c_str(), zip_error_strerror(&pze));
+				parallel_failed_entry.store(SavestateEntries[i]->GetFilename(), std::memory_order_release);
+				return;
+			}
+
+			auto zff = zip_fopen_index_managed(pzf.get(), entryIndices[i], 0);
+			ZipReadStream stream(zff.get());
+			if (!zff || !SavestateEntries[i]->FreezeIn(&stream))
+			{
+				parallel_failed_entry.store(SavestateEntries[i]->GetFilename(), std::memory_order_release);
+				return;
+			}
 		}
+	});
+
+	const char* failed_entry = LoadStateEntries(entryIndices, true, [&zf](u32 i, s64 index) {
+		auto zff = zip_fopen_index_managed(zf.get(), index, 0);
+		ZipReadStream stream(zff.get());
+		return (zff && SavestateEntries[i]->FreezeIn(&stream));
+	});
+
+	parallel_thread.join();
+	if (!failed_entry)
+		failed_entry = parallel_failed_entry.load(std::memory_order_acquire);
+
+	if (failed_entry)
+	{
+		Error::SetString(error, fmt::format("Save state corruption in {}.", failed_entry));
+		VMManager::Reset();
+		return false;
 	}
-	if (!allPresent)
+
+	PostLoadPrep();
+	return true;
+}
+
+static s64 FindEntryInList(const ArchiveEntryList& srclist, const char* name)
+{
+	for (size_t i = 0; i < srclist.GetLength(); i++)
+	{
+		const ArchiveEntry& entry = srclist[static_cast<uint>(i)];
+		if (entry.GetFilename() == name && entry.GetDataSize() > 0)
+			return static_cast<s64>(i);
+	}
+
+	return -1;
+}
+
+bool SaveState_LoadFromMemory(const ArchiveEntryList& srclist, Error* error)
+{
+	s64 internal_index;
+	s64 entryIndices[std::size(SavestateEntries)];
+	if (!FindStateEntries([&srclist](const char* name, bool) { return FindEntryInList(srclist, name); },
+			&internal_index, entryIndices, error))
 	{
-		Error::SetString(error, "Some required components were not found or are incomplete.");
 		return false;
 	}
 
 	PreLoadPrep();
 
-	if (!LoadInternalStructuresState(zf.get(), internal_index, error))
+	// Internal structures are always first when downloaded, so we can avoid copying them.
+	const ArchiveEntry& internals = srclist[static_cast<uint>(internal_index)];
+	std::optional<SaveStateBase::VmStateBuffer> internals_copy;
+	if (internals.GetDataIndex() != 0)
+	{
+		const u8* ptr = srclist.GetPtr(internals.GetDataIndex());
+		internals_copy.emplace(ptr, ptr + internals.GetDataSize());
+	}
+
+	if (!LoadInternalStructuresState(internals_copy.has_value() ? internals_copy.value() : srclist.GetBuffer(), error))
 	{
 		if (!error->IsValid())
 			Error::SetString(error, "Save state corruption in internal structures.");
@@ -1214,21 +1420,16 @@ bool SaveState_UnzipFromDisk(const std::string& filename, Error* error)
 		return false;
 	}
 
-	for (u32 i = 0; i < std::size(SavestateEntries); ++i)
+	const char* failed_entry = LoadStateEntries(entryIndices, false, [&srclist](u32 i, s64 index) {
+		const ArchiveEntry& entry = srclist[static_cast<uint>(index)];
+		StateWrapper::ReadOnlyMemoryStream stream(srclist.GetPtr(entry.GetDataIndex()), entry.GetDataSize());
+		return SavestateEntries[i]->FreezeIn(&stream);
+	});
+	if (failed_entry)
 	{
-		if (entryIndices[i] < 0)
-		{
-			SavestateEntries[i]->FreezeIn(nullptr);
-			continue;
-		}
-
-		auto zff = zip_fopen_index_managed(zf.get(), entryIndices[i], 0);
-		if (!zff || !SavestateEntries[i]->FreezeIn(zff.get()))
-		{
-			Error::SetString(error, fmt::format("Save state corruption in {}.", SavestateEntries[i]->GetFilename()));
-			VMManager::Reset();
-			return false;
-		}
+		Error::SetString(error, fmt::format("Save state corruption in {}.", failed_entry));
+		VMManager::Reset();
+		return false;
 	}
 
 	PostLoadPrep();
@@ -29,6 +29,7 @@
 #include "PerformanceMetrics.h"
 #include "R3000A.h"
 #include "R5900.h"
+#include "Rewind.h"
 #include "Recording/InputRecording.h"
 #include "Recording/InputRecordingControls.h"
 #include "SIO/Memcard/MemoryCardFile.h"
@@ -47,6 +48,7 @@
 #include "common/Error.h"
 #include "common/FileSystem.h"
 #include "common/FPControl.h"
+#include "common/Perf.h"
 #include "common/ScopedGuard.h"
 #include "common/SettingsWrapper.h"
 #include "common/SmallString.h"
@@ -135,6 +137,7 @@ namespace VMManager
 	static void ResetResumeTimestamp();
 	static void SaveSessionTime(const std::string& prev_serial);
 	static void ReloadPINE();
+	static void WriteSamplingProfile();
 
 	static float GetTargetSpeedForLimiterMode(LimiterModeType mode);
 	static void ResetFrameLimiter();
@@ -184,6 +187,10 @@ static bool s_fast_boot_requested = false;
 static bool s_gs_open_on_initialize = false;
 static bool s_thread_affinities_set = false;
 
+// Serial the sampling profiler's current samples belong to.
+static std::string s_sampling_serial;
+static constexpr u32 SAMPLING_INTERVAL_US = 1000;
+
 static LimiterModeType s_limiter_mode = LimiterModeType::Nominal;
 static s64 s_limiter_ticks_per_frame = 0;
 static u64 s_limiter_frame_start = 0;
@@ -1143,6 +1150,20 @@ void VMManager::UpdateDiscDetails(bool booting)
 	Console.WriteLn(Color_StrongGreen, fmt::format("  Version: {}", s_disc_version));
 	Console.WriteLn(Color_StrongGreen, fmt::format("  CRC: {:08X}", s_disc_crc));
 
+	if constexpr (newVifDynaRec)
+	{
+		// VIF1 unpacks may be compiling on the VU thread.
+		if (THREAD_VU1)
+			vu1Thread.WaitVU();
+		dVifOpenProfile(s_disc_serial, s_disc_crc);
+	}
+
+	if (Perf::IsSampling())
+	{
+		WriteSamplingProfile();
+		s_sampling_serial = s_disc_serial;
+	}
+
 	UpdateGameSettingsLayer();
 	ApplySettings();
 
@@ -1624,6 +1645,13 @@ VMBootResult VMManager::Initialize(const VMBootParameters& boot_params, Error* e
 	if (EmuConfig.CdvdPrecache)
 		PrecacheCDVDFile();
 
+	if (Perf::StartSampling(SAMPLING_INTERVAL_US))
+	{
+		// The disc details were read above, before sampling started, so they haven't set the serial.
+		s_sampling_serial = s_disc_serial;
+		Console.WriteLn("Sampling profiler started, reports will be written to the logs directory.");
+	}
+
 	hwReset();
 
 	Console.WriteLn("VM subsystems initialized in %.2f ms", init_timer.GetTimeMilliseconds());
@@ -1677,6 +1705,16 @@ void VMManager::Shutdown(bool save_resume_state)
 	if (g_InputRecording.isActive())
 		g_InputRecording.stop();
 
+	if constexpr (newVifDynaRec)
+		dVifCloseProfile();
+
+	if (Perf::IsSampling())
+	{
+		WriteSamplingProfile();
+		Perf::StopSampling();
+		s_sampling_serial = {};
+	}
+
 	SaveSessionTime(s_disc_serial);
 	s_elf_override = {};
 	ClearELFInfo();
@@ -1707,6 +1745,7 @@ void VMManager::Shutdown(bool save_resume_state)
 	g_Sio2.Shutdown();
 	g_Sio0.Shutdown();
 	MemcardBusy::ClearBusy();
+	Rewind::Shutdown();
 	DEV9close();
 	DoCDVDclose();
 	FWclose();
@@ -1793,6 +1832,7 @@ void VMManager::Reset()
 		HandleELFChange(false);
 
 	Achievements::ResetClient();
+	Rewind::Reset();
 
 	mmap_ResetBlockTracking();
 	memSetExtraMemMode(EmuConfig.Cpu.ExtraMemory);
@@ -1906,6 +1946,9 @@ bool VMManager::DoLoadState(const char* filename, Error* error)
 	if (!SaveState_UnzipFromDisk(filename, error))
 		return false;
 
+	// Earlier states belong to a different timeline now.
+	Rewind::Reset();
+
 	Host::OnSaveStateLoaded(filename, true);
 	if (g_InputRecording.isActive())
 	{
@@ -2073,6 +2116,35 @@ bool VMManager::LoadState(const char* filename, Error* error)
 	return true;
 }
 
+bool VMManager::RewindState(Error* error)
+{
+	if (Achievements::IsHardcoreModeActive())
+	{
+		Error::SetString(error,
+			TRANSLATE_STR("VMManager", "Cannot rewind while RetroAchievements Hardcore Mode is active."));
+		return false;
+	}
+
+	if (MemcardBusy::IsBusy())
+	{
+		Error::SetString(error,
+			TRANSLATE_STR("VMManager", "The memory card is busy, so the rewind operation has been cancelled to prevent data loss."));
+		return false;
+	}
+
+	if (!Rewind::StepBack(error))
+		return false;
+
+	if (g_InputRecording.isActive())
+	{
+		g_InputRecording.handleLoadingSavestate();
+		MTGS::PresentCurrentFrame();
+	}
+
+	MemcardBusy::CheckSaveStateDependency();
+	return true;
+}
+
 bool VMManager::LoadStateFromSlot(s32 slot, bool backup, Error* error)
 {
 	const std::string filename = GetCurrentSaveStateFileName(slot, backup);
@@ -2743,6 +2815,9 @@ void VMManager::Internal::ClearCPUExecutionCaches()
 	{
 		dVifReset(0);
 		dVifReset(1);
+
+		// Not done for resets when the cache fills up, only when the state changes under the game.
+		dVifQueueProfile();
 	}
 }
 
@@ -2759,6 +2834,9 @@ void VMManager::Execute()
 
 	// Execute until we're asked to stop.
 	Cpu->Execute();
+
+	// States can only be captured between executions, not from within an event.
+	Rewind::ProcessPendingCapture();
 }
 
 void VMManager::IdlePollUpdate()
@@ -2919,6 +2997,14 @@ void VMManager::Internal::VSyncOnCPUThread()
 
 	Achievements::FrameUpdate();
 
+	if (EmuConfig.EnablePINE)
+		PINEServer::OnVSync();
+
+	if (EmuConfig.Savestate.RewindEnable && !Achievements::IsHardcoreModeActive())
+		Rewind::OnVSync();
+
+	Perf::DrainSamples();
+
 	PollDiscordPresence();
 }
 
@@ -3126,6 +3212,9 @@ void VMManager::CheckForConfigChanges(const Pcsx2Config& old_config)
 	if (EmuConfig.Achievements != old_config.Achievements)
 		Achievements::UpdateSettings(old_config.Achievements);
 
+	if (EmuConfig.Savestate != old_config.Savestate)
+		Rewind::Reset();
+
 	FullscreenUI::CheckForConfigChanges(old_config);
 
 	CheckForMiscConfigChanges(old_config);
@@ -3760,6 +3849,16 @@ void VMManager::ReloadPINE()
 		PINEServer::Initialize(EmuConfig.PINESlot);
 }
 
+void VMManager::WriteSamplingProfile()
+{
+	const std::string path = Path::Combine(EmuFolders::Logs,
+		fmt::format("profile_{}.txt", s_sampling_serial.empty() ? std::string_view("unknown") : std::string_view(s_sampling_serial)));
+	if (Perf::WriteSamplingReport(path.c_str()))
+		Console.WriteLn(fmt::format("Wrote sampling profile to '{}'.", path));
+	else
+		Console.Error(fmt::format("Failed to write sampling profile to '{}'.", path));
+}
+
 void VMManager::InitializeDiscordPresence()
 {
 	if (s_discord_presence_active)
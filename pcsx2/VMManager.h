@@ -170,6 +170,9 @@ namespace VMManager
 	/// Loads state from the specified slot.
 	bool LoadStateFromSlot(s32 slot, bool backup = false, Error* error = nullptr);
 
+	/// Steps back to the previous state in the rewind buffer.
+	bool RewindState(Error* error = nullptr);
+
 	/// Saves state to the specified filename.
 	void SaveState(const char* filename, bool zip_on_thread, bool backup_old_state,
 		std::function<void(const std::string&)> error_callback);
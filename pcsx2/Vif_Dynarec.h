@@ -7,6 +7,9 @@
 #include "Vif_HashBucket.h"
 #include "VU.h"
 
+#include <string>
+#include <unordered_set>
+
 typedef u32 (*nVifCall)(void*, const void*);
 typedef void (*nVifrecCall)(uptr dest, uptr src);
 
@@ -14,9 +17,37 @@ extern void _nVifUnpack(int idx, const u8* data, uint mode, bool isFill);
 extern void dVifReset(int idx);
 extern void dVifRelease(int idx);
 extern void VifUnpackSSE_Init();
+extern void dVifOpenProfile(const std::string& serial, u32 crc);
+extern void dVifCloseProfile();
+// Compiles the open profile again after the code cache is cleared, e.g. on a state load.
+// Must be called with the VU thread idle, like dVifOpenProfile().
+extern void dVifQueueProfile();
 
 _vifT extern void dVifUnpack(const u8* data, bool isFill);
 
+// Key of a compiled unpack block (see dVifUnpack), recorded per game so that the
+// blocks can be compiled up front on the next boot instead of on first use.
+struct nVifProfileEntry
+{
+	u16 hash_key;
+	u16 isFill;
+	u32 key0;
+	u32 key1;
+
+	bool operator==(const nVifProfileEntry& rhs) const
+	{
+		return hash_key == rhs.hash_key && isFill == rhs.isFill && key0 == rhs.key0 && key1 == rhs.key1;
+	}
+};
+
+struct nVifProfileEntryHash
+{
+	size_t operator()(const nVifProfileEntry& e) const
+	{
+		return std::hash<u64>()((static_cast<u64>(e.key1) << 32 | e.key0) ^ (static_cast<u64>(e.hash_key) << 8 | e.isFill));
+	}
+};
+
 struct nVifStruct
 {
 	// Buffer for partial transfers (should always be first to ensure alignment)
@@ -33,6 +64,12 @@ struct nVifStruct
 
 	HashBucket              vifBlocks;   // Vif Blocks
 
+	// Blocks seen by this game, loaded from its profile and added to as new blocks are compiled.
+	// Only touched by the thread running the unpacks, or while that thread is idle.
+	std::unordered_set<nVifProfileEntry, nVifProfileEntryHash> profile;
+	bool                    profileDirty;   // New blocks since the profile was loaded
+	bool                    profilePending; // Profile needs compiling before the next unpack, set when a game is opened
+
 
 	nVifStruct() = default;
 };
@@ -7,6 +7,13 @@
 #include "Vif_Dynarec.h"
 #include "MTVU.h"
 
+#include "common/KeyProfile.h"
+#include "common/Path.h"
+
+#include "fmt/format.h"
+
+#include <cstring>
+
 enum UnpackOffset {
 	OFFSET_X = 0,
 	OFFSET_Y = 1,
@@ -321,6 +328,74 @@ void releaseNewVif(int idx)
 {
 }
 
+// --------------------------------------------------------------------------------------
+//  Unpack Profiles
+// --------------------------------------------------------------------------------------
+// The keys of every block compiled for a game are saved to the cache directory, and
+// compiled ahead of time the next time the game is booted or a state is loaded.
+
+static constexpr u32 VIF_PROFILE_MAGIC = 0x50464956; // VIFP
+static constexpr u32 VIF_PROFILE_VERSION = 1;
+
+static std::string s_vif_profile_path;
+
+static std::string GetVifProfilePath(const std::string& serial, u32 crc)
+{
+	return Path::Combine(EmuFolders::Cache, Path::SanitizeFileName(fmt::format("vif_{}_{:08X}.bin", serial, crc)));
+}
+
+static void LoadVifProfile(const std::string& path)
+{
+	std::vector<nVifProfileEntry> entries[2];
+	if (!KeyProfile::Load(path, VIF_PROFILE_MAGIC, VIF_PROFILE_VERSION, &entries[0], &entries[1]))
+		return;
+
+	nVif[0].profile.insert(entries[0].begin(), entries[0].end());
+	nVif[1].profile.insert(entries[1].begin(), entries[1].end());
+
+	DevCon.WriteLn("nVif: Loaded unpack profile with %zu VIF0 and %zu VIF1 blocks", entries[0].size(), entries[1].size());
+}
+
+static void SaveVifProfile(const std::string& path)
+{
+	if (!KeyProfile::Save<nVifProfileEntry>(path, VIF_PROFILE_MAGIC, VIF_PROFILE_VERSION, nVif[0].profile, nVif[1].profile))
+		Console.Error("nVif: Failed to write unpack profile '%s'", path.c_str());
+}
+
+// Must be called with the VU thread idle, since the profiles are shared with VIF1 unpacks.
+void dVifOpenProfile(const std::string& serial, u32 crc)
+{
+	dVifCloseProfile();
+
+	if (serial.empty())
+		return;
+
+	s_vif_profile_path = GetVifProfilePath(serial, crc);
+	LoadVifProfile(s_vif_profile_path);
+
+	dVifQueueProfile();
+}
+
+void dVifQueueProfile()
+{
+	// Compile on the next unpack, rather than here, so it happens on the thread owning the code cache.
+	nVif[0].profilePending = !nVif[0].profile.empty();
+	nVif[1].profilePending = !nVif[1].profile.empty();
+}
+
+void dVifCloseProfile()
+{
+	if (!s_vif_profile_path.empty() && (nVif[0].profileDirty || nVif[1].profileDirty))
+		SaveVifProfile(s_vif_profile_path);
+
+	s_vif_profile_path = {};
+	for (nVifStruct& v : nVif)
+	{
+		v.profile.clear();
+		v.profileDirty = false;
+	}
+}
+
 static __fi u8* getVUptr(uint idx, int offset)
 {
 	return (u8*)(vuRegs[idx].Mem + (offset & (idx ? 0x3ff0 : 0xff0)));
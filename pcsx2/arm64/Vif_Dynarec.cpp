@@ -498,6 +498,40 @@ _vifT __fi nVifBlock* dVifCompile(nVifBlock& block, bool isFill)
 	return &block;
 }
 
+// Compiles the blocks recorded in the game's profile, so they don't stall the first unpack using them.
+// Runs on the thread doing the unpacks, since that thread owns the block cache and code buffer.
+_vifT static void dVifCompileProfile()
+{
+	nVifStruct& v = nVif[idx];
+	v.profilePending = false;
+	if (v.profile.empty())
+		return;
+
+	// Leave half of the cache for blocks which the profile hasn't seen.
+	const u8* limit = v.recWritePtr + (v.recEndPtr - v.recWritePtr) / 2;
+	const u8* start = v.recWritePtr;
+	u32 count = 0;
+
+	for (const nVifProfileEntry& entry : v.profile)
+	{
+		if (v.recWritePtr >= limit)
+			break;
+
+		nVifBlock block = {};
+		block.hash_key = entry.hash_key;
+		block.key0 = entry.key0;
+		block.key1 = entry.key1;
+		if (v.vifBlocks.find(block))
+			continue;
+
+		dVifCompile<idx>(block, entry.isFill != 0);
+		count++;
+	}
+
+	DevCon.WriteLn("nVif%d: Compiled %u of %zu profiled blocks (%zu bytes)", idx, count, v.profile.size(),
+		static_cast<size_t>(v.recWritePtr - start));
+}
+
 _vifT __fi void dVifUnpack(const u8* data, bool isFill)
 {
 	nVifStruct& v = nVif[idx];
@@ -535,11 +569,15 @@ _vifT __fi void dVifUnpack(const u8* data, bool isFill)
 	//	doMask >> 4, doMask ? wxsFormat( L"0x%08x", block.mask ).c_str() : L"ignored"
 	//);
 
+	if (v.profilePending) [[unlikely]]
+		dVifCompileProfile<idx>();
+
 	// Seach in cache before trying to compile the block
 	nVifBlock* b = v.vifBlocks.find(block);
 	if (!b) [[unlikely]]
 	{
 		b = dVifCompile<idx>(block, isFill);
+		v.profileDirty |= v.profile.insert({static_cast<u16>(hash_key), isFill, key0, key1}).second;
 	}
 
 	{ // Execute the block
@@ -3,8 +3,12 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstring>
-#include <map>
+#include <deque>
+#include <set>
+#include <unordered_map>
+#include <vector>
 
 #include "common/Assertions.h"
 
@@ -34,120 +38,198 @@ struct BASEBLOCKEX
 #endif
 };
 
+// Blocks are bucketed by the guest page their start pc lies in, with each bucket sorted by
+// start pc. Compiling or invalidating a block only shuffles the few blocks sharing its page,
+// rather than every block above it, so games which churn code don't pay for the whole array.
+// BASEBLOCKEX pointers stay valid until the block is erased.
 class BaseBlockArray
 {
-	s32 _Reserved;
-	s32 _Size;
-	BASEBLOCKEX* blocks;
+	static constexpr u32 PAGE_SHIFT = 12;
 
-	__fi void resize(s32 size)
+	using Bucket = std::vector<BASEBLOCKEX*>;
+
+	std::unordered_map<u32, Bucket> m_pages;
+	std::set<u32> m_used_pages; // for walking between neighbouring pages in order
+	std::deque<BASEBLOCKEX> m_storage;
+	std::vector<BASEBLOCKEX*> m_free;
+	u32 m_size = 0;
+
+	static Bucket::const_iterator UpperBound(const Bucket& bucket, u32 startpc)
 	{
-		pxAssert(size > 0);
-		BASEBLOCKEX* newMem = new BASEBLOCKEX[size];
-		if (blocks)
-		{
-			memcpy(newMem, blocks, _Reserved * sizeof(BASEBLOCKEX));
-			delete[] blocks;
-		}
-		blocks = newMem;
-		pxAssert(blocks != NULL);
+		return std::upper_bound(bucket.begin(), bucket.end(), startpc,
+			[](u32 pc, const BASEBLOCKEX* block) { return pc < block->startpc; });
 	}
 
-	void reserve(u32 size)
+	static Bucket::const_iterator LowerBound(const Bucket& bucket, u32 startpc)
 	{
-		resize(size);
-		_Reserved = size;
+		return std::lower_bound(bucket.begin(), bucket.end(), startpc,
+			[](const BASEBLOCKEX* block, u32 pc) { return block->startpc < pc; });
 	}
 
-public:
-	~BaseBlockArray()
+	const Bucket* GetBucket(u32 page) const
 	{
-		if (blocks)
-			delete[] blocks;
+		const auto it = m_pages.find(page);
+		return (it != m_pages.end()) ? &it->second : nullptr;
 	}
 
-	BaseBlockArray(s32 size)
-		: _Reserved(0)
-		, _Size(0)
-		, blocks(NULL)
+	BASEBLOCKEX* LastInPageBefore(u32 page) const
 	{
-		reserve(size);
+		auto it = m_used_pages.lower_bound(page);
+		if (it == m_used_pages.begin())
+			return nullptr;
+
+		return GetBucket(*--it)->back();
+	}
+
+	BASEBLOCKEX* FirstInPageAfter(u32 page) const
+	{
+		const auto it = m_used_pages.upper_bound(page);
+		if (it == m_used_pages.end())
+			return nullptr;
+
+		return GetBucket(*it)->front();
+	}
+
+public:
+	BaseBlockArray(u32 reserve)
+	{
+		m_pages.reserve(reserve >> 4);
 	}
 
 	BASEBLOCKEX* insert(u32 startpc, uptr fnptr)
 	{
-		if (_Size + 1 >= _Reserved)
+		BASEBLOCKEX* block;
+		if (!m_free.empty())
+		{
+			block = m_free.back();
+			m_free.pop_back();
+		}
+		else
 		{
-			reserve(_Reserved + 0x2000); // some games requires even more!
+			block = &m_storage.emplace_back();
 		}
 
-		// Insert the the new BASEBLOCKEX by startpc order
-		int imin = 0, imax = _Size, imid;
+		std::memset(block, 0, sizeof(BASEBLOCKEX));
+		block->startpc = startpc;
+		block->fnptr = fnptr;
 
-		while (imin < imax)
-		{
-			imid = (imin + imax) >> 1;
+		const u32 page = startpc >> PAGE_SHIFT;
+		Bucket& bucket = m_pages[page];
+		if (bucket.empty())
+			m_used_pages.insert(page);
 
-			if (blocks[imid].startpc > startpc)
-				imax = imid;
-			else
-				imin = imid + 1;
-		}
+		const auto pos = UpperBound(bucket, startpc);
+		pxAssert(pos == bucket.end() || (*pos)->startpc > startpc);
+		bucket.insert(pos, block);
 
-		pxAssert(imin == _Size || blocks[imin].startpc > startpc);
+		m_size++;
+		return block;
+	}
 
-		if (imin < _Size)
+	/// Returns the last block starting at or before startpc.
+	BASEBLOCKEX* last(u32 startpc) const
+	{
+		const u32 page = startpc >> PAGE_SHIFT;
+		if (const Bucket* bucket = GetBucket(page))
 		{
-			// make a hole for a new block.
-			memmove(blocks + imin + 1, blocks + imin, (_Size - imin) * sizeof(BASEBLOCKEX));
+			const auto it = UpperBound(*bucket, startpc);
+			if (it != bucket->begin())
+				return *(it - 1);
 		}
 
-		memset((blocks + imin), 0, sizeof(BASEBLOCKEX));
-		blocks[imin].startpc = startpc;
-		blocks[imin].fnptr = fnptr;
+		return LastInPageBefore(page);
+	}
+
+	/// Returns the block following block in start pc order.
+	BASEBLOCKEX* next(const BASEBLOCKEX* block) const
+	{
+		const u32 page = block->startpc >> PAGE_SHIFT;
+		const Bucket& bucket = *GetBucket(page);
+		const auto it = UpperBound(bucket, block->startpc);
+		return (it != bucket.end()) ? *it : FirstInPageAfter(page);
+	}
 
-		_Size++;
-		return &blocks[imin];
+	/// Returns the block preceding block in start pc order.
+	BASEBLOCKEX* prev(const BASEBLOCKEX* block) const
+	{
+		const u32 page = block->startpc >> PAGE_SHIFT;
+		const Bucket& bucket = *GetBucket(page);
+		const auto it = LowerBound(bucket, block->startpc);
+		return (it != bucket.begin()) ? *(it - 1) : LastInPageBefore(page);
 	}
 
-	__fi BASEBLOCKEX& operator[](int idx) const
+	BASEBLOCKEX* first() const
 	{
-		return *(blocks + idx);
+		return m_used_pages.empty() ? nullptr : GetBucket(*m_used_pages.begin())->front();
 	}
 
 	void clear()
 	{
-		_Size = 0;
+		m_pages.clear();
+		m_used_pages.clear();
+		m_storage.clear();
+		m_free.clear();
+		m_size = 0;
 	}
 
 	__fi u32 size() const
 	{
-		return _Size;
+		return m_size;
 	}
 
-	__fi void erase(s32 first, s32 last)
+	/// Erases all blocks from first to last inclusive, in start pc order.
+	void erase(BASEBLOCKEX* first, BASEBLOCKEX* last)
 	{
-		int range = last - first;
+		pxAssert(first->startpc <= last->startpc);
 
-		if (last < _Size)
+		const u32 first_page = first->startpc >> PAGE_SHIFT;
+		const u32 last_page = last->startpc >> PAGE_SHIFT;
+		const u32 first_pc = first->startpc;
+		const u32 last_pc = last->startpc;
+
+		for (auto it = m_used_pages.lower_bound(first_page); it != m_used_pages.end() && *it <= last_page;)
 		{
-			memmove(blocks + first, blocks + last, (_Size - last) * sizeof(BASEBLOCKEX));
-		}
+			const auto bucket_it = m_pages.find(*it);
+			Bucket& bucket = bucket_it->second;
+			const auto begin = LowerBound(bucket, first_pc);
+			const auto end = UpperBound(bucket, last_pc);
+			for (auto block = begin; block != end; ++block)
+				m_free.push_back(*block);
 
-		_Size -= range;
+			m_size -= static_cast<u32>(end - begin);
+			bucket.erase(begin, end);
+
+			if (bucket.empty())
+			{
+				m_pages.erase(bucket_it);
+				it = m_used_pages.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
 	}
 };
 
 class BaseBlocks
 {
 protected:
-	typedef std::multimap<u32, uptr>::iterator linkiter_t;
-
-	// switch to a hash map later?
-	std::multimap<u32, uptr> links;
+	// Jumps waiting on each guest pc, repointed whenever the block there is compiled or removed.
+	std::unordered_map<u32, std::vector<uptr>> links;
 	uptr recompiler;
 	BaseBlockArray blocks;
 
+	void UpdateLinks(u32 pc, uptr target)
+	{
+		const auto it = links.find(pc);
+		if (it == links.end())
+			return;
+
+		for (const uptr jumpptr : it->second)
+			*(u32*)jumpptr = target - (jumpptr + 4);
+	}
+
 public:
 	BaseBlocks()
 		: recompiler(0)
@@ -161,45 +243,48 @@ public:
 	}
 
 	BASEBLOCKEX* New(u32 startpc, uptr fnptr);
-	int LastIndex(u32 startpc) const;
-	//BASEBLOCKEX* GetByX86(uptr ip);
 
-	__fi int Index(u32 startpc) const
+	/// Returns the last block starting at or before startpc.
+	__fi BASEBLOCKEX* GetLast(u32 startpc) const
+	{
+		return blocks.last(startpc);
+	}
+
+	__fi BASEBLOCKEX* Get(u32 startpc) const
 	{
-		int idx = LastIndex(startpc);
+		BASEBLOCKEX* block = blocks.last(startpc);
 
-		if ((idx == -1) || (startpc < blocks[idx].startpc) ||
-			((blocks[idx].size) && (startpc >= blocks[idx].startpc + blocks[idx].size * 4)))
-			return -1;
+		if (!block || ((block->size) && (startpc >= block->startpc + block->size * 4)))
+			return nullptr;
 		else
-			return idx;
+			return block;
 	}
 
-	__fi BASEBLOCKEX* operator[](int idx)
+	__fi BASEBLOCKEX* Next(const BASEBLOCKEX* block) const
 	{
-		if (idx < 0 || idx >= (int)blocks.size())
-			return 0;
+		return blocks.next(block);
+	}
 
-		return &blocks[idx];
+	__fi BASEBLOCKEX* Prev(const BASEBLOCKEX* block) const
+	{
+		return blocks.prev(block);
 	}
 
-	__fi BASEBLOCKEX* Get(u32 startpc)
+	template <typename T>
+	__fi void ForEach(const T& callback) const
 	{
-		return (*this)[Index(startpc)];
+		for (BASEBLOCKEX* block = blocks.first(); block; block = blocks.next(block))
+			callback(block);
 	}
 
-	__fi void Remove(int first, int last)
+	/// Removes all blocks from first to last inclusive, in start pc order.
+	__fi void Remove(BASEBLOCKEX* first, BASEBLOCKEX* last)
 	{
-		pxAssert(first <= last);
-		int idx = first;
-		do
+		pxAssert(first->startpc <= last->startpc);
+		BASEBLOCKEX* block = first;
+		for (;;)
 		{
-			pxAssert(idx <= last);
-
-			//u32 startpc = blocks[idx].startpc;
-			std::pair<linkiter_t, linkiter_t> range = links.equal_range(blocks[idx].startpc);
-			for (linkiter_t i = range.first; i != range.second; ++i)
-				*(u32*)i->second = recompiler - (i->second + 4);
+			UpdateLinks(block->startpc, recompiler);
 
 			if (IsDevBuild)
 			{
@@ -208,13 +293,19 @@ public:
 				// first byte, since this code is called during exception handlers and event handlers
 				// both of which expect to be able to return to the recompiled code.
 
-				BASEBLOCKEX effu(blocks[idx]);
+				BASEBLOCKEX effu(*block);
 				memset((void*)effu.fnptr, 0xcc, 1);
 			}
-		} while (idx++ < last);
+
+			if (block == last)
+				break;
+
+			block = blocks.next(block);
+			pxAssert(block);
+		}
 
 		// TODO: remove links from this block?
-		blocks.erase(first, last + 1);
+		blocks.erase(first, last);
 	}
 
 	void Link(u32 pc, s32* jumpptr);
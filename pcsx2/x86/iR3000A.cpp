@@ -68,6 +68,7 @@ static u32 s_nInstCacheSize = 0;
 
 static BASEBLOCK* s_pCurBlock = nullptr;
 static BASEBLOCKEX* s_pCurBlockEx = nullptr;
+static std::vector<Perf::PCMapping> s_perf_mappings;
 
 static u32 s_nEndBlock = 0; // what psxpc the current block ends
 static u32 s_branchTo;
@@ -1092,21 +1093,21 @@ static __fi u32 psxRecClearMem(u32 pc)
 	pc = HWADDR(pc);
 
 	u32 lowerextent = pc, upperextent = pc + 4;
-	int blockidx = recBlocks.Index(pc);
-	pxAssert(blockidx != -1);
+	BASEBLOCKEX* toRemoveFirst = recBlocks.Get(pc);
+	pxAssert(toRemoveFirst);
 
-	while (BASEBLOCKEX* pexblock = recBlocks[blockidx - 1])
+	while (BASEBLOCKEX* pexblock = recBlocks.Prev(toRemoveFirst))
 	{
 		if (pexblock->startpc + pexblock->size * 4 <= lowerextent)
 			break;
 
 		lowerextent = std::min(lowerextent, pexblock->startpc);
-		blockidx--;
+		toRemoveFirst = pexblock;
 	}
 
-	int toRemoveFirst = blockidx;
+	BASEBLOCKEX* toRemoveLast = nullptr;
 
-	while (BASEBLOCKEX* pexblock = recBlocks[blockidx])
+	for (BASEBLOCKEX* pexblock = toRemoveFirst; pexblock; pexblock = recBlocks.Next(pexblock))
 	{
 		if (pexblock->startpc >= upperextent)
 			break;
@@ -1114,22 +1115,24 @@ static __fi u32 psxRecClearMem(u32 pc)
 		lowerextent = std::min(lowerextent, pexblock->startpc);
 		upperextent = std::max(upperextent, pexblock->startpc + pexblock->size * 4);
 
-		blockidx++;
+		toRemoveLast = pexblock;
 	}
 
-	if (toRemoveFirst != blockidx)
+	if (toRemoveLast)
 	{
-		recBlocks.Remove(toRemoveFirst, (blockidx - 1));
+		recBlocks.Remove(toRemoveFirst, toRemoveLast);
 	}
 
-	blockidx = 0;
-	while (BASEBLOCKEX* pexblock = recBlocks[blockidx++])
+	// Walking every block is far too slow to do on each clear outside of development builds.
+	if (IsDevBuild)
 	{
-		if (pc >= pexblock->startpc && pc < pexblock->startpc + pexblock->size * 4) [[unlikely]]
-		{
-			DevCon.Error("[IOP] Impossible block clearing failure");
-			pxFail("[IOP] Impossible block clearing failure");
-		}
+		recBlocks.ForEach([pc](const BASEBLOCKEX* pexblock) {
+			if (pc >= pexblock->startpc && pc < pexblock->startpc + pexblock->size * 4) [[unlikely]]
+			{
+				DevCon.Error("[IOP] Impossible block clearing failure");
+				pxFail("[IOP] Impossible block clearing failure");
+			}
+		});
 	}
 
 	iopClearRecLUT(PSX_GETBLOCK(lowerextent), upperextent - lowerextent);
@@ -1491,6 +1494,9 @@ static bool psxEncodeMemcheck()
 
 void psxRecompileNextInstruction(bool delayslot, bool swapped_delayslot)
 {
+	if (Perf::IsRecordingDebugInfo())
+		s_perf_mappings.push_back({xGetPtr(), psxpc});
+
 #ifdef DUMP_BLOCKS
 	const bool dump_block = true;
 
@@ -1618,6 +1624,8 @@ static void iopRecRecompile(const u32 startpc)
 	u32 i;
 	u32 link_next_block = 0;
 
+	s_perf_mappings.clear();
+
 	// When upgrading the IOP, there are two resets, the second of which is a 'fake' reset
 	// This second 'reset' involves UDNL calling SYSMEM and LOADCORE directly, resetting LOADCORE's modules
 	// This detects when SYSMEM is called and clears the modules then
@@ -1840,7 +1848,7 @@ StartRecomp:
 	pxAssert(xGetPtr() - recPtr < _64kb);
 	s_pCurBlockEx->x86size = xGetPtr() - recPtr;
 
-	Perf::iop.RegisterPC((void*)s_pCurBlockEx->fnptr, s_pCurBlockEx->x86size, s_pCurBlockEx->startpc);
+	Perf::iop.RegisterPC((void*)s_pCurBlockEx->fnptr, s_pCurBlockEx->x86size, s_pCurBlockEx->startpc, s_perf_mappings);
 
 	recPtr = xGetPtr();
 
@@ -89,6 +89,7 @@ static u32 s_nInstCacheSize = 0;
 
 static BASEBLOCK* s_pCurBlock = nullptr;
 static BASEBLOCKEX* s_pCurBlockEx = nullptr;
+static std::vector<Perf::PCMapping> s_perf_mappings;
 u32 s_nEndBlock = 0; // what pc the current block ends
 u32 s_branchTo;
 static bool s_nBlockFF;
@@ -811,20 +812,21 @@ void recClear(u32 addr, u32 size)
 		return;
 	addr = HWADDR(addr);
 
-	int blockidx = recBlocks.LastIndex(addr + size * 4 - 4);
+	BASEBLOCKEX* pexblock = recBlocks.GetLast(addr + size * 4 - 4);
 
-	if (blockidx == -1)
+	if (!pexblock)
 		return;
 
 	u32 lowerextent = static_cast<u32>(-1), upperextent = 0, ceiling = static_cast<u32>(-1);
 
-	BASEBLOCKEX* pexblock = recBlocks[blockidx + 1];
-	if (pexblock)
-		ceiling = pexblock->startpc;
+	if (BASEBLOCKEX* nextblock = recBlocks.Next(pexblock))
+		ceiling = nextblock->startpc;
 
-	int toRemoveLast = blockidx;
+	// Blocks are removed in contiguous runs, split around the block currently being compiled.
+	BASEBLOCKEX* toRemoveFirst = nullptr;
+	BASEBLOCKEX* toRemoveLast = nullptr;
 
-	while ((pexblock = recBlocks[blockidx]))
+	for (; pexblock; pexblock = recBlocks.Prev(pexblock))
 	{
 		u32 blockstart = pexblock->startpc;
 		u32 blockend = pexblock->startpc + pexblock->size * 4;
@@ -832,11 +834,11 @@ void recClear(u32 addr, u32 size)
 
 		if (pblock == s_pCurBlock)
 		{
-			if (toRemoveLast != blockidx)
+			if (toRemoveLast)
 			{
-				recBlocks.Remove((blockidx + 1), toRemoveLast);
+				recBlocks.Remove(toRemoveFirst, toRemoveLast);
 			}
-			toRemoveLast = --blockidx;
+			toRemoveFirst = toRemoveLast = nullptr;
 			continue;
 		}
 
@@ -850,26 +852,31 @@ void recClear(u32 addr, u32 size)
 		upperextent = std::max(upperextent, blockend);
 		pblock->SetFnptr((uptr)JITCompile);
 
-		blockidx--;
+		toRemoveFirst = pexblock;
+		if (!toRemoveLast)
+			toRemoveLast = pexblock;
 	}
 
-	if (toRemoveLast != blockidx)
+	if (toRemoveLast)
 	{
-		recBlocks.Remove((blockidx + 1), toRemoveLast);
+		recBlocks.Remove(toRemoveFirst, toRemoveLast);
 	}
 
 	upperextent = std::min(upperextent, ceiling);
 
-	for (int i = 0; (pexblock = recBlocks[i]); i++)
+	// Walking every block is far too slow to do on each clear outside of development builds.
+	if (IsDevBuild)
 	{
-		if (s_pCurBlock == PC_GETBLOCK(pexblock->startpc))
-			continue;
-		u32 blockend = pexblock->startpc + pexblock->size * 4;
-		if ((pexblock->startpc >= addr && pexblock->startpc < addr + size * 4) || (pexblock->startpc < addr && blockend > addr)) [[unlikely]]
-		{
-			Console.Error("[EE] Impossible block clearing failure");
-			pxFail("[EE] Impossible block clearing failure");
-		}
+		recBlocks.ForEach([addr, size](const BASEBLOCKEX* pexblock) {
+			if (s_pCurBlock == PC_GETBLOCK(pexblock->startpc))
+				return;
+			u32 blockend = pexblock->startpc + pexblock->size * 4;
+			if ((pexblock->startpc >= addr && pexblock->startpc < addr + size * 4) || (pexblock->startpc < addr && blockend > addr)) [[unlikely]]
+			{
+				Console.Error("[EE] Impossible block clearing failure");
+				pxFail("[EE] Impossible block clearing failure");
+			}
+		});
 	}
 
 	if (upperextent > lowerextent)
@@ -1687,6 +1694,9 @@ bool encodeMemcheck()
 
 void recompileNextInstruction(bool delayslot, bool swapped_delay_slot)
 {
+	if (Perf::IsRecordingDebugInfo())
+		s_perf_mappings.push_back({xGetPtr(), pc});
+
 	if (EmuConfig.EnablePatches)
 		Patch::ApplyDynamicPatches(pc);
 
@@ -2200,6 +2210,7 @@ static void recRecompile(const u32 startpc)
 	u32 willbranch3 = 0;
 
 	pxAssert(startpc);
+	s_perf_mappings.clear();
 
 	// if recPtr reached the mem limit reset whole mem
 	if (recPtr >= recPtrEnd)
@@ -2675,11 +2686,7 @@ StartRecomp:
 
 	if (HWADDR(pc) <= Ps2MemSize::ExposedRam)
 	{
-		BASEBLOCKEX* oldBlock;
-		int i;
-
-		i = recBlocks.LastIndex(HWADDR(pc) - 4);
-		while ((oldBlock = recBlocks[i--]))
+		for (BASEBLOCKEX* oldBlock = recBlocks.GetLast(HWADDR(pc) - 4); oldBlock; oldBlock = recBlocks.Prev(oldBlock))
 		{
 			if (oldBlock == s_pCurBlockEx)
 				continue;
@@ -2755,7 +2762,7 @@ StartRecomp:
 		iDumpBlock(s_pCurBlockEx->startpc, s_pCurBlockEx->size*4, s_pCurBlockEx->fnptr, s_pCurBlockEx->x86size);
 	}
 #endif
-	Perf::ee.RegisterPC((void*)s_pCurBlockEx->fnptr, s_pCurBlockEx->x86size, s_pCurBlockEx->startpc);
+	Perf::ee.RegisterPC((void*)s_pCurBlockEx->fnptr, s_pCurBlockEx->x86size, s_pCurBlockEx->startpc, s_perf_mappings);
 
 	recPtr = xGetPtr();
 
@@ -868,6 +868,7 @@ void* mVUcompile(microVU& mVU, u32 startPC, uptr pState)
 	u32 x = 0;
 
 	mvuPreloadRegisters(mVU, endCount);
+	std::vector<Perf::PCMapping> perf_mappings;
 
 	for (; x < endCount; x++)
 	{
@@ -897,6 +898,9 @@ void* mVUcompile(microVU& mVU, u32 startPC, uptr pState)
 			mVU_XGKICK_SYNC(mVU, false);
 		}
 
+		if (Perf::IsRecordingDebugInfo())
+			perf_mappings.push_back({xGetPtr(), xPC});
+
 		mVUexecuteInstruction(mVU);
 		if (!mVUinfo.isBdelay && !mVUlow.branch) //T/D Bit on branch is handled after the branch, branch delay slots are executed.
 		{
@@ -1005,9 +1009,9 @@ perf_and_return:
 	if (mVU.regs().start_pc == startPC)
 	{
 		if (mVU.index)
-			Perf::vu1.RegisterPC(thisPtr, static_cast<u32>(x86Ptr - thisPtr), startPC);
+			Perf::vu1.RegisterPC(thisPtr, static_cast<u32>(x86Ptr - thisPtr), startPC, perf_mappings);
 		else
-			Perf::vu0.RegisterPC(thisPtr, static_cast<u32>(x86Ptr - thisPtr), startPC);
+			Perf::vu0.RegisterPC(thisPtr, static_cast<u32>(x86Ptr - thisPtr), startPC, perf_mappings);
 	}
 
 	return thisPtr;
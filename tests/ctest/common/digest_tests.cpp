@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "common/MD5Digest.h"
+#include "common/SHA1Digest.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+
+static std::string ToHex(const u8* data, size_t size)
+{
+	static constexpr char hex_chars[] = "0123456789abcdef";
+	std::string ret;
+	for (size_t i = 0; i < size; i++)
+	{
+		ret.push_back(hex_chars[data[i] >> 4]);
+		ret.push_back(hex_chars[data[i] & 0xf]);
+	}
+	return ret;
+}
+
+static std::string MD5(std::string_view str)
+{
+	MD5Digest md5;
+	md5.Update(str.data(), static_cast<u32>(str.size()));
+	u8 digest[16];
+	md5.Final(digest);
+	return ToHex(digest, sizeof(digest));
+}
+
+static std::string SHA1(std::string_view str)
+{
+	SHA1Digest sha1;
+	sha1.Update(str.data(), static_cast<u32>(str.size()));
+	u8 digest[SHA1Digest::DIGEST_SIZE];
+	sha1.Final(digest);
+	return ToHex(digest, sizeof(digest));
+}
+
+TEST(Digest, MD5)
+{
+	EXPECT_EQ(MD5(""), "d41d8cd98f00b204e9800998ecf8427e");
+	EXPECT_EQ(MD5("abc"), "900150983cd24fb0d6963f7d28e17f72");
+	EXPECT_EQ(MD5("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"), "8215ef0796a20bcaaae116d3876c664a");
+}
+
+TEST(Digest, SHA1)
+{
+	EXPECT_EQ(SHA1(""), "da39a3ee5e6b4b0d3255bfef95601890afd80709");
+	EXPECT_EQ(SHA1("abc"), "a9993e364706816aba3e25717850c26c9cd0d89d");
+	EXPECT_EQ(SHA1("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"), "84983e441c3bd26ebaae4aa1f95129e5e54670f1");
+}
+
+TEST(Digest, SHA1Chunked)
+{
+	// Odd sized updates, so blocks straddle calls.
+	const std::vector<u8> data(1000000, 'a');
+	SHA1Digest sha1;
+	for (size_t pos = 0; pos < data.size(); pos += 333)
+		sha1.Update(data.data() + pos, static_cast<u32>(std::min<size_t>(333, data.size() - pos)));
+
+	u8 digest[SHA1Digest::DIGEST_SIZE];
+	sha1.Final(digest);
+	EXPECT_EQ(ToHex(digest, sizeof(digest)), "34aa973cd4c4daa4f61eeb2bdbad27316534016f");
+}
@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "pcsx2/GS/Renderers/HW/GSTextureCache.h"
+#include <gtest/gtest.h>
+
+using Source = GSTextureCache::Source;
+using SourceMap = GSTextureCache::SourceMap;
+
+static GIFRegTEX0 MakeTEX0(u32 bp)
+{
+	GIFRegTEX0 TEX0 = {};
+	TEX0.TBP0 = bp;
+	TEX0.TBW = 2;
+	TEX0.PSM = PSMCT32;
+	TEX0.TW = 7;
+	TEX0.TH = 5;
+	return TEX0;
+}
+
+// Adds a source with the given TEX0 that covers the pages of the rect.
+static Source* AddSource(SourceMap& map, const GIFRegTEX0& TEX0, const GSVector4i& rect)
+{
+	Source* s = new Source(TEX0, GIFRegTEXA{});
+	s->m_pages = GSOffset(GSLocalMemory::swizzle32, TEX0.TBP0, TEX0.TBW, TEX0.PSM).pageLooperForRect(rect);
+	map.Add(s, TEX0);
+	return s;
+}
+
+static Source* Lookup(SourceMap& map, const GIFRegTEX0& TEX0, u32 page)
+{
+	const GIFRegCLAMP CLAMP = {};
+	return map.Lookup(TEX0, GIFRegTEXA{}, GSLocalMemory::m_psm[TEX0.PSM], nullptr, nullptr, GSVector2i(0, 0),
+		GSTextureCache::SourceRegion(), 0, page, CLAMP, GSVector4i(0, 0, 128, 32));
+}
+
+TEST(SourceMap, LookupMiss)
+{
+	SourceMap map;
+	AddSource(map, MakeTEX0(0), GSVector4i(0, 0, 128, 32));
+
+	EXPECT_EQ(Lookup(map, MakeTEX0(64), 2), nullptr);
+	EXPECT_EQ(Lookup(map, MakeTEX0(0), 5), nullptr);
+
+	map.RemoveAll();
+}
+
+TEST(SourceMap, LookupMultipleMatchesUsesPageOrder)
+{
+	SourceMap map;
+	const GIFRegTEX0 TEX0 = MakeTEX0(0);
+
+	// Both sources match TEX0, but only the first one is on page 1.
+	Source* const wide = AddSource(map, TEX0, GSVector4i(0, 0, 128, 32));
+	Source* const narrow = AddSource(map, TEX0, GSVector4i(0, 0, 64, 32));
+	EXPECT_EQ(Lookup(map, TEX0, 0), narrow);
+
+	// Using the wide source on page 1 makes it the most recently used overall,
+	// but the narrow source is still in front of it on page 0.
+	EXPECT_EQ(Lookup(map, TEX0, 1), wide);
+	EXPECT_EQ(Lookup(map, TEX0, 0), narrow);
+	EXPECT_EQ(*map.m_map[0].begin(), narrow);
+
+	map.RemoveAt(narrow);
+	EXPECT_EQ(Lookup(map, TEX0, 0), wide);
+	EXPECT_EQ(*map.m_map[0].begin(), wide);
+
+	map.RemoveAll();
+	EXPECT_TRUE(map.m_lookup.empty());
+}
@@ -0,0 +1,140 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "pcsx2/IPU/IPU_MultiISA.h"
+#include "pcsx2/IPU/yuv2rgb.h"
+#include "pcsx2/GS/MultiISA.h"
+
+#include "common/Timer.h"
+
+#include "../MultiISATest.h"
+
+#include <cstring>
+#include <random>
+
+MULTI_ISA_UNSHARED_START
+
+static constexpr int NUM_ROUNDS = 2000;
+
+static void RandomFill(void* data, size_t size, std::mt19937& rng)
+{
+	u8* bytes = static_cast<u8*>(data);
+	for (size_t i = 0; i < size; i++)
+		bytes[i] = static_cast<u8>(rng());
+}
+
+// Mostly random, but with a good share of the extremes where the clamping happens.
+static void RandomFillBiased(void* data, size_t size, std::mt19937& rng)
+{
+	static constexpr u8 edges[] = {0x00, 0x01, 0x0f, 0x10, 0x11, 0x40, 0x7f, 0x80, 0x81, 0xef, 0xf0, 0xfe, 0xff};
+
+	u8* bytes = static_cast<u8*>(data);
+	for (size_t i = 0; i < size; i++)
+		bytes[i] = ((rng() & 3) == 0) ? edges[rng() % std::size(edges)] : static_cast<u8>(rng());
+}
+
+MULTI_ISA_TEST(IPUColourTest, YUV2RGB)
+{
+	SKIP_IF_UNSUPPORTED();
+
+	std::mt19937 rng(1234);
+	macroblock_rgb32 expected;
+
+	for (int round = 0; round < NUM_ROUNDS; round++)
+	{
+		RandomFillBiased(&decoder.mb8, sizeof(decoder.mb8), rng);
+
+		yuv2rgb_reference();
+		std::memcpy(&expected, &decoder.rgb32, sizeof(expected));
+		std::memset(&decoder.rgb32, 0, sizeof(decoder.rgb32));
+
+		yuv2rgb();
+		ASSERT_EQ(std::memcmp(&expected, &decoder.rgb32, sizeof(expected)), 0) << "round " << round;
+	}
+}
+
+MULTI_ISA_TEST(IPUColourTest, Dither)
+{
+	SKIP_IF_UNSUPPORTED();
+
+	std::mt19937 rng(5678);
+	alignas(32) macroblock_rgb32 rgb32;
+	alignas(32) macroblock_rgb16 expected;
+	alignas(32) macroblock_rgb16 actual;
+
+	for (int round = 0; round < NUM_ROUNDS; round++)
+	{
+		RandomFillBiased(&rgb32, sizeof(rgb32), rng);
+
+		for (int dte = 0; dte < 2; dte++)
+		{
+			ipu_dither_reference(rgb32, expected, dte);
+			ipu_dither(rgb32, actual, dte);
+			ASSERT_EQ(std::memcmp(&expected, &actual, sizeof(expected)), 0) << "round " << round << " dte " << dte;
+		}
+	}
+}
+
+MULTI_ISA_TEST(IPUColourTest, VectorQuantise)
+{
+	SKIP_IF_UNSUPPORTED();
+
+	std::mt19937 rng(9012);
+	alignas(32) macroblock_rgb16 rgb16;
+	alignas(16) u8 expected[16 * 16 / 2];
+	alignas(16) u8 actual[16 * 16 / 2];
+
+	for (int round = 0; round < NUM_ROUNDS; round++)
+	{
+		RandomFill(&rgb16, sizeof(rgb16), rng);
+		RandomFill(g_ipu_vqclut, sizeof(g_ipu_vqclut), rng);
+
+		// Repeated and equidistant entries, to check which index wins a tie.
+		if (round & 1)
+		{
+			for (int k = 0; k < 16; k++)
+			{
+				g_ipu_vqclut[k].r = (rng() & 1) ? 0 : 31;
+				g_ipu_vqclut[k].g = (rng() & 1) ? 0 : 31;
+				g_ipu_vqclut[k].b = 15 + (rng() & 1);
+			}
+		}
+
+		ipu_vq_reference(rgb16, expected);
+		ipu_vq(rgb16, actual);
+		ASSERT_EQ(std::memcmp(expected, actual, sizeof(expected)), 0) << "round " << round;
+	}
+}
+
+// Not a correctness test, reports the per-macroblock cost of each kernel against the reference.
+// Disabled so it doesn't slow down normal runs, use --gtest_also_run_disabled_tests to run it.
+MULTI_ISA_TEST(IPUColourTest, DISABLED_Benchmark)
+{
+	SKIP_IF_UNSUPPORTED();
+
+	static constexpr int NUM_MACROBLOCKS = 20000;
+
+	std::mt19937 rng(3456);
+	RandomFill(&decoder.mb8, sizeof(decoder.mb8), rng);
+	RandomFill(g_ipu_vqclut, sizeof(g_ipu_vqclut), rng);
+	alignas(16) u8 indx4[16 * 16 / 2];
+
+	const auto time = [](const auto& kernel) {
+		Common::Timer timer;
+		for (int i = 0; i < NUM_MACROBLOCKS; i++)
+			kernel();
+		return timer.GetTimeMilliseconds() * 1000.0 / NUM_MACROBLOCKS;
+	};
+
+	const double csc_ref = time([] { yuv2rgb_reference(); });
+	const double csc = time([] { yuv2rgb(); });
+	const double dither_ref = time([] { ipu_dither_reference(decoder.rgb32, decoder.rgb16, 1); });
+	const double dither = time([] { ipu_dither(decoder.rgb32, decoder.rgb16, 1); });
+	const double vq_ref = time([&indx4] { ipu_vq_reference(decoder.rgb16, indx4); });
+	const double vq = time([&indx4] { ipu_vq(decoder.rgb16, indx4); });
+
+	std::printf("Per macroblock: CSC %.3fus (reference %.3fus), dither %.3fus (reference %.3fus), VQ %.3fus (reference %.3fus)\n",
+		csc, csc_ref, dither, dither_ref, vq, vq_ref);
+}
+
+MULTI_ISA_UNSHARED_END
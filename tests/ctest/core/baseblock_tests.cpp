@@ -0,0 +1,153 @@
+// SPDX-FileCopyrightText: 2002-2026 PCSX2 Dev Team
+// SPDX-License-Identifier: GPL-3.0+
+
+#include "x86/BaseblockEx.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+
+// Checks the array against a reference ordered map, walking it both ways.
+static void CheckBlocks(const BaseBlockArray& blocks, const std::map<u32, uptr>& expected)
+{
+	ASSERT_EQ(blocks.size(), expected.size());
+
+	const BASEBLOCKEX* block = blocks.first();
+	for (const auto& [startpc, fnptr] : expected)
+	{
+		ASSERT_NE(block, nullptr);
+		EXPECT_EQ(block->startpc, startpc);
+		EXPECT_EQ(block->fnptr, fnptr);
+		block = blocks.next(block);
+	}
+	EXPECT_EQ(block, nullptr);
+
+	if (expected.empty())
+		return;
+
+	block = blocks.last(0xFFFFFFFFu);
+	for (auto it = expected.rbegin(); it != expected.rend(); ++it)
+	{
+		ASSERT_NE(block, nullptr);
+		EXPECT_EQ(block->startpc, it->first);
+		block = blocks.prev(block);
+	}
+	EXPECT_EQ(block, nullptr);
+}
+
+TEST(BaseBlockArray, InsertKeepsOrder)
+{
+	BaseBlockArray blocks(0x100);
+	std::map<u32, uptr> expected;
+
+	for (const u32 pc : {0x2000u, 0x100u, 0x5000u, 0x104u, 0x1FFCu, 0x3000u, 0x0u})
+	{
+		blocks.insert(pc, pc + 1);
+		expected.emplace(pc, pc + 1);
+	}
+
+	CheckBlocks(blocks, expected);
+}
+
+TEST(BaseBlockArray, LastFindsPrecedingBlock)
+{
+	BaseBlockArray blocks(0x100);
+	blocks.insert(0x1000, 1);
+	blocks.insert(0x1010, 2);
+	blocks.insert(0x8000, 3);
+
+	EXPECT_EQ(blocks.last(0x0FFC), nullptr);
+	EXPECT_EQ(blocks.last(0x1000)->startpc, 0x1000u);
+	EXPECT_EQ(blocks.last(0x100C)->startpc, 0x1000u);
+	EXPECT_EQ(blocks.last(0x1010)->startpc, 0x1010u);
+	EXPECT_EQ(blocks.last(0x4000)->startpc, 0x1010u); // empty page, falls back to the previous one
+	EXPECT_EQ(blocks.last(0x9000)->startpc, 0x8000u);
+}
+
+TEST(BaseBlockArray, EraseAcrossPages)
+{
+	BaseBlockArray blocks(0x100);
+	std::map<u32, uptr> expected;
+
+	for (u32 pc = 0; pc < 0x10000; pc += 0x100)
+	{
+		blocks.insert(pc, pc);
+		expected.emplace(pc, pc);
+	}
+
+	blocks.erase(blocks.last(0x0F00), blocks.last(0x3100));
+	expected.erase(expected.find(0x0F00), expected.upper_bound(0x3100));
+	CheckBlocks(blocks, expected);
+
+	blocks.erase(blocks.first(), blocks.first());
+	expected.erase(expected.begin());
+	CheckBlocks(blocks, expected);
+
+	blocks.erase(blocks.first(), blocks.last(0xFFFFFFFFu));
+	expected.clear();
+	CheckBlocks(blocks, expected);
+}
+
+TEST(BaseBlockArray, RandomChurn)
+{
+	BaseBlockArray blocks(0x4000);
+	std::map<u32, uptr> expected;
+	std::mt19937 rng(1234);
+
+	for (int i = 0; i < 20000; i++)
+	{
+		const u32 pc = (rng() % 0x80000) * 4;
+		if ((rng() % 3) != 0)
+		{
+			if (expected.emplace(pc, i).second)
+				blocks.insert(pc, i);
+		}
+		else if (!expected.empty())
+		{
+			// Remove a short run of neighbouring blocks, like an invalidation would.
+			auto first = expected.lower_bound(pc);
+			if (first == expected.end())
+				first = expected.begin();
+			auto last = first;
+			for (u32 count = rng() % 4; count > 0 && std::next(last) != expected.end(); count--)
+				++last;
+
+			blocks.erase(blocks.last(first->first), blocks.last(last->first));
+			expected.erase(first, std::next(last));
+		}
+	}
+
+	CheckBlocks(blocks, expected);
+}
+
+// A compile/invalidate storm over a large block set, like a game recompiling the same code repeatedly.
+TEST(BaseBlockArray, RecompileChurn)
+{
+	static constexpr u32 NUM_BLOCKS = 200000;
+	static constexpr u32 NUM_ROUNDS = 100000;
+
+	BaseBlockArray blocks(0x4000);
+	std::map<u32, uptr> expected;
+	std::mt19937 rng(5678);
+
+	for (u32 i = 0; i < NUM_BLOCKS; i++)
+	{
+		blocks.insert(i * 16, i);
+		expected.emplace(i * 16, i);
+	}
+
+	for (u32 i = 0; i < NUM_ROUNDS; i++)
+	{
+		// Invalidate a block somewhere in the middle of memory, then recompile it.
+		const u32 pc = (rng() % NUM_BLOCKS) * 16;
+		BASEBLOCKEX* block = blocks.last(pc);
+		ASSERT_NE(block, nullptr);
+		ASSERT_EQ(block->startpc, pc);
+		blocks.erase(block, block);
+		blocks.insert(pc, NUM_BLOCKS + i);
+		expected[pc] = NUM_BLOCKS + i;
+	}
+
+	CheckBlocks(blocks, expected);
+}